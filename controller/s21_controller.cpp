@@ -8,6 +8,52 @@ double Controller::calculate(const std::string expr, const std::string x) {
 
 double Controller::calculate(double x) { return calculator_.GetResult(x); }
 
+/* Same as calculate(expr, x), but reparses only the changed end of expression.
+ * Intended for calls on every edit of expression. */
+double Controller::calculateLive(const std::string expr, const std::string x) {
+  calculator_.SetX(x);
+  calculator_.UpdateExpression(expr);
+  return calculator_.GetResult();
+}
+
+/* Parse expression for block calculation. Only changed end of expression is
+ * parsed again. */
+bool Controller::prepare(const std::string expr) {
+  calculator_.UpdateExpression(expr);
+  return calculator_.Compile();
+}
+
+/* Calculate prepared expression for 'count' values of x at once. */
+bool Controller::calculate(const double *x, double *y, size_t count) const {
+  return calculator_.GetResults(x, y, count);
+}
+
+/* Same for expression of x and y. May be called from several threads. */
+bool Controller::calculate(const double *x, const double *y, double *z,
+                           size_t count) const {
+  return calculator_.GetResults(x, y, z, count);
+}
+
+/* Definite integral of prepared expression over [a, b] with estimate of its
+ * error. Returns false if expression is invalid, integral does not reach
+ * required accuracy or integration was stopped by 'proceed'. */
+bool Controller::integrate(double a, double b, double &value, double &error,
+                           const Integration::Proceed &proceed) const {
+  Integration::Result result;
+  bool valid = Integration().Integrate(calculator_, a, b, result, proceed);
+  value = result.value;
+  error = result.error;
+  return valid == true && result.converged == true;
+}
+
+/* Write table of prepared expression for x from a to b with step into file. */
+Table::Status Controller::writeTable(double a, double b, double step,
+                                     const std::string &path,
+                                     const Table::Options &options,
+                                     const Table::Progress &progress) const {
+  return Table(options).Write(calculator_, a, b, step, path, progress);
+}
+
 void Controller::setRadian() noexcept { calculator_.SetRadian(); }
 
 void Controller::setDegree() noexcept { calculator_.SetDegree(); }
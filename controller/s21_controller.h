@@ -2,6 +2,8 @@
 #define S21_CONTROLLER_H
 
 #include "./../model/s21_calculation.h"
+#include "./../model/s21_integration.h"
+#include "./../model/s21_table.h"
 
 namespace s21 {
 class Controller {
@@ -11,6 +13,17 @@ class Controller {
 
   double calculate(const std::string expr, const std::string x);
   double calculate(double x);
+  double calculateLive(const std::string expr, const std::string x);
+  bool prepare(const std::string expr);
+  bool calculate(const double *x, double *y, size_t count) const;
+  bool calculate(const double *x, const double *y, double *z,
+                 size_t count) const;
+  bool integrate(double a, double b, double &value, double &error,
+                 const Integration::Proceed &proceed = nullptr) const;
+  Table::Status writeTable(double a, double b, double step,
+                           const std::string &path,
+                           const Table::Options &options,
+                           const Table::Progress &progress = nullptr) const;
   void setRadian() noexcept;
   void setDegree() noexcept;
   bool isSuccessful() const noexcept;
@@ -22,6 +22,8 @@ SOURCES += \
     calculator.cpp \
     creditcalculator.cpp \
     depositcalculator.cpp \
+    plotworker.cpp \
+    tableworker.cpp \
     qcustomplot.cpp \
     main.cpp \
     mainwindow.cpp
@@ -33,6 +35,8 @@ HEADERS += \
     calculator.h \
     creditcalculator.h \
     depositcalculator.h \
+    plotworker.h \
+    tableworker.h \
     qcustomplot.h \
     mainwindow.h
 
@@ -1,16 +1,29 @@
 #include "calculator.h"
 
+#include <QFileDialog>
+#include <QInputDialog>
+#include <QMessageBox>
+
 #include "ui_calculator.h"
 
 Calculator::Calculator(QWidget *parent)
     : QWidget(parent), ui(new Ui::Calculator) {
   ui->setupUi(this);
   ctrl.setRadian();
+  initializeWorker();
   initializeGraph();
   connectSignals();
 }
 
-Calculator::~Calculator() { delete ui; }
+Calculator::~Calculator() {
+  generation++;
+  plot_thread.quit();
+  plot_thread.wait();
+  table_cancelled = true;
+  table_thread.quit();
+  table_thread.wait();
+  delete ui;
+}
 
 void Calculator::setDefaultFocus() { ui->lineEditExpression->setFocus(); }
 
@@ -28,10 +41,44 @@ void Calculator::nullDefaultSizes() {
   ui->widgetPlot->setMinimumHeight(0);
 }
 
+void Calculator::initializeWorker() {
+  worker = new PlotWorker(generation, samples);
+  worker->moveToThread(&plot_thread);
+  connect(&plot_thread, &QThread::finished, worker, &QObject::deleteLater);
+  connect(this, &Calculator::plotRequested, worker, &PlotWorker::compute,
+          Qt::QueuedConnection);
+  connect(this, &Calculator::curvesRequested, worker,
+          &PlotWorker::computeCurves, Qt::QueuedConnection);
+  connect(worker, &PlotWorker::curveComputed, this, &Calculator::applyCurve,
+          Qt::QueuedConnection);
+  connect(this, &Calculator::heatmapRequested, worker,
+          &PlotWorker::computeHeatmap, Qt::QueuedConnection);
+  connect(worker, &PlotWorker::heatmapComputed, this,
+          &Calculator::applyHeatmap, Qt::QueuedConnection);
+  connect(this, &Calculator::implicitRequested, worker,
+          &PlotWorker::computeImplicit, Qt::QueuedConnection);
+  connect(this, &Calculator::integralRequested, worker,
+          &PlotWorker::computeIntegral, Qt::QueuedConnection);
+  connect(worker, &PlotWorker::integralComputed, this,
+          &Calculator::applyIntegral, Qt::QueuedConnection);
+  table_worker = new TableWorker(table_cancelled);
+  table_worker->moveToThread(&table_thread);
+  connect(&table_thread, &QThread::finished, table_worker,
+          &QObject::deleteLater);
+  connect(this, &Calculator::tableRequested, table_worker,
+          &TableWorker::write, Qt::QueuedConnection);
+  connect(table_worker, &TableWorker::progressed, this,
+          &Calculator::showTableProgress, Qt::QueuedConnection);
+  connect(table_worker, &TableWorker::written, this,
+          &Calculator::finishTable, Qt::QueuedConnection);
+  table_thread.start();
+  frame_timer.setInterval(FRAME_INTERVAL);
+  connect(&frame_timer, &QTimer::timeout, this, &Calculator::drainPlot);
+  plot_thread.start();
+}
+
 void Calculator::initializeGraph() {
   size = ui->widgetPlot->width();
-  x.resize(size);
-  y.resize(size);
   ui->widgetPlot->setBackground(QColor(238, 237, 247, 255));
   ui->widgetPlot->xAxis->setLabelFont(QFont("Anta", 14));
   ui->widgetPlot->yAxis->setLabelFont(QFont("Anta", 14));
@@ -50,7 +97,8 @@ void Calculator::initializeGraph() {
   ui->widgetPlot->setInteraction(QCP::iRangeDrag, true);
   ui->widgetPlot->setInteraction(QCP::iRangeZoom, true);
   ui->widgetPlot->addGraph();
-  ui->widgetPlot->graph(0)->setPen(QPen(Qt::black, 1));
+  ui->widgetPlot->graph(0)->setPen(QPen(GRAPH_COLORS[0], 1));
+  ui->widgetPlot->graph(0)->data()->set(QVector<QCPGraphData>(size), true);
   ui->widgetPlot->xAxis->setLabel("X axis");
   ui->widgetPlot->yAxis->setLabel("Y axis");
   setRange();
@@ -67,9 +115,16 @@ void Calculator::connectSignals() {
           SLOT(calculateResult()));
   connect(ui->lineEditX, SIGNAL(returnPressed()), this,
           SLOT(calculateResult()));
+  connect(ui->lineEditExpression, SIGNAL(textChanged(QString)), this,
+          SLOT(previewResult()));
+  connect(ui->lineEditX, SIGNAL(textChanged(QString)), this,
+          SLOT(previewResult()));
   connect(ui->radioButtonRad, SIGNAL(clicked()), this, SLOT(setRadian()));
   connect(ui->radioButtonDeg, SIGNAL(clicked()), this, SLOT(setDegree()));
+  connect(ui->comboBoxPlotMode, SIGNAL(currentIndexChanged(int)), this,
+          SLOT(setPlotMode(int)));
   connect(ui->pushButtonPlot, SIGNAL(clicked()), this, SLOT(setRange()));
+  connect(ui->pushButtonTable, SIGNAL(clicked()), this, SLOT(exportTable()));
   connect(ui->doubleSpinBoxMinX, SIGNAL(editingFinished()), this,
           SLOT(setRange()));
   connect(ui->doubleSpinBoxMaxX, SIGNAL(editingFinished()), this,
@@ -132,9 +187,9 @@ void Calculator::connectSignals() {
 
 /* Produce result and call plot graph */
 void Calculator::calculateResult() {
-  QString result = doubleToQString(
-      ctrl.calculate(ui->lineEditExpression->text().toStdString(),
-                     ui->lineEditX->text().toStdString()));
+  QString result = doubleToQString(ctrl.calculate(
+      ui->lineEditExpression->text().section(';', 0, 0).toStdString(),
+      ui->lineEditX->text().toStdString()));
   if (ctrl.isEmpty() == true)
     result.clear();
   else if (ctrl.isSuccessful() == false)
@@ -143,6 +198,20 @@ void Calculator::calculateResult() {
   setRange();
 }
 
+/* Live preview of result and graph while expression is being typed. Only
+ * changed part of expression is parsed again. Errors are not shown until
+ * expression is submitted, because incomplete input is usually invalid. */
+void Calculator::previewResult() {
+  double result = ctrl.calculateLive(
+      ui->lineEditExpression->text().section(';', 0, 0).toStdString(),
+      ui->lineEditX->text().toStdString());
+  if (ctrl.isSuccessful() == true)
+    ui->lineEditResult->setText(doubleToQString(result));
+  else
+    ui->lineEditResult->clear();
+  plotGraph();
+}
+
 /* When called set limits from ui. If limits is changed plot graph by
  * "changeRange" signal, otherwise directly plot graph. */
 void Calculator::setRange() {
@@ -196,21 +265,245 @@ void Calculator::changeRangeY(const QCPRange &range) {
   plotGraph();
 }
 
-/* Slot to replot graph. */
+/* Slot to replot graphs. Expressions are separated by ';', each one gets its
+ * own graph. Samples are computed in worker thread, any request that is still
+ * in progress is cancelled. Computed samples are picked up by frame timer. */
 void Calculator::plotGraph() {
-  double step = (max_x - min_x) / size;
-  for (int i = 0; i < size; ++i) {
-    x[i] = min_x + i * step;
-    y[i] = ctrl.calculate(x[i]);
+  QStringList expressions = ui->lineEditExpression->text().split(';');
+  if (plot_mode != FUNCTION) ui->labelIntegral->clear();
+  if (plot_mode == HEATMAP) {
+    frame_timer.stop();
+    emit heatmapRequested(++generation, expressions.first(),
+                          ui->radioButtonDeg->isChecked(), min_x, max_x,
+                          ui->widgetPlot->width(), min_y, max_y,
+                          ui->widgetPlot->height());
+    return;
+  }
+  if (plot_mode == IMPLICIT) {
+    frame_timer.stop();
+    emit implicitRequested(++generation, expressions,
+                           ui->radioButtonDeg->isChecked(), min_x, max_x,
+                           min_y, max_y,
+                           qMax(1, ui->widgetPlot->width() / IMPLICIT_CELL),
+                           qMax(1, ui->widgetPlot->height() / IMPLICIT_CELL));
+    return;
+  }
+  if (plot_mode != FUNCTION) {
+    frame_timer.stop();
+    emit curvesRequested(++generation, expressions,
+                         ui->radioButtonDeg->isChecked(), plot_mode,
+                         (max_x - min_x) / qMax(1, ui->widgetPlot->width()),
+                         (max_y - min_y) / qMax(1, ui->widgetPlot->height()));
+    return;
+  }
+  plot_grid = s21::SampleCache::MakeGrid(min_x, max_x, size);
+  plot_size = plot_grid.count;
+  plot_graphs = expressions.size();
+  emit plotRequested(++generation, expressions,
+                     ui->radioButtonDeg->isChecked(), plot_grid.level,
+                     plot_grid.first, plot_grid.count);
+  emit integralRequested(generation, expressions.first(),
+                         ui->radioButtonDeg->isChecked(), min_x, max_x);
+  frame_timer.start();
+}
+
+/* Slot to receive curve of parametric or polar mode. Curves that are not
+ * needed anymore are removed. Index is -1 when there are no curves at all. */
+void Calculator::applyCurve(quint64 number, int index, int count,
+                            QVector<double> t, QVector<double> x,
+                            QVector<double> y) {
+  if (number != generation) return;
+  while (curves.size() > count)
+    ui->widgetPlot->removePlottable(curves.takeLast());
+  while (curves.size() < count) {
+    QCPCurve *curve =
+        new QCPCurve(ui->widgetPlot->xAxis, ui->widgetPlot->yAxis);
+    curve->setPen(QPen(GRAPH_COLORS[curves.size() % GRAPH_COLORS.size()], 1));
+    curves.append(curve);
+  }
+  if (index >= 0 && index < count) curves[index]->setData(t, x, y, true);
+  ui->widgetPlot->replot();
+}
+
+/* Slot to receive heatmap values, stored row by row from the lowest y. */
+void Calculator::applyHeatmap(quint64 number, double lower_x, double upper_x,
+                              int size_x, double lower_y, double upper_y,
+                              int size_y, QVector<double> values) {
+  if (number != generation) return;
+  if (color_map == nullptr) {
+    color_map = new QCPColorMap(ui->widgetPlot->xAxis, ui->widgetPlot->yAxis);
+    QCPColorGradient gradient(QCPColorGradient::gpThermal);
+    gradient.setNanHandling(QCPColorGradient::nhTransparent);
+    color_map->setGradient(gradient);
   }
-  ui->widgetPlot->graph(0)->setData(x, y, true);
+  QCPColorMapData *data = color_map->data();
+  data->setSize(size_x, size_y);
+  data->setRange(QCPRange(lower_x, upper_x), QCPRange(lower_y, upper_y));
+  for (int j = 0; j < size_y; ++j)
+    for (int i = 0; i < size_x; ++i)
+      data->setCell(i, j, values[j * size_x + i]);
+  color_map->rescaleDataRange(true);
   ui->widgetPlot->replot();
 }
 
+/* Slot to receive integral of the first function over plot range. Error is
+ * shown only if integral has not reached required accuracy. */
+void Calculator::applyIntegral(quint64 number, double lower, double upper,
+                               double value, double error, bool valid) {
+  if (number != generation) return;
+  QString text = QString("∫[%1; %2] = %3")
+                     .arg(doubleToQString(lower), doubleToQString(upper),
+                          doubleToQString(value));
+  if (valid == false && qIsFinite(value)) {
+    text += " ± " + QString::number(error, 'g', 2);
+  } else if (valid == false) {
+    text = QString("∫[%1; %2] undefined")
+               .arg(doubleToQString(lower), doubleToQString(upper));
+  }
+  ui->labelIntegral->setText(ui->lineEditExpression->text().isEmpty()
+                                 ? QString()
+                                 : text);
+}
+
+/* Slot to switch between function, curve and heatmap plots. */
+void Calculator::setPlotMode(int mode) {
+  plot_mode = static_cast<PlotMode>(mode);
+  ui->widgetPlot->clearPlottables();
+  curves.clear();
+  color_map = nullptr;
+  exact.clear();
+  drawn_generation = 0;
+  plotGraph();
+  ui->widgetPlot->replot();
+}
+
+/* Slot to export table of the first expression over plot range. Step and
+ * file are asked in dialogs. While table is written, button cancels it. */
+void Calculator::exportTable() {
+  if (table_running == true) {
+    table_cancelled = true;
+    return;
+  }
+  bool ok = false;
+  double step = QInputDialog::getDouble(this, "Table", "Step of x:",
+                                        (max_x - min_x) / 100, 1e-12, 1e12,
+                                        12, &ok);
+  if (ok == false) return;
+  QString path = QFileDialog::getSaveFileName(
+      this, "Save table", "table.csv", "CSV (*.csv);;Binary (*.bin)");
+  if (path.isEmpty() == true) return;
+  table_cancelled = false;
+  table_running = true;
+  ui->pushButtonTable->setText("Cancel");
+  emit tableRequested(ui->lineEditExpression->text().section(';', 0, 0),
+                      ui->radioButtonDeg->isChecked(), min_x, max_x, step,
+                      path);
+}
+
+void Calculator::showTableProgress(int percent) {
+  ui->pushButtonTable->setText(QString("Cancel %1%").arg(percent));
+}
+
+void Calculator::finishTable(int status, qint64 rows) {
+  table_running = false;
+  ui->pushButtonTable->setText("Table");
+  if (status == s21::Table::COMPLETED || status == s21::Table::CANCELLED)
+    return;
+  QString reason = "Error in expression.";
+  if (status == s21::Table::RANGE_ERROR)
+    reason = "Step gives no rows or too many rows.";
+  else if (status == s21::Table::OPEN_ERROR)
+    reason = "File can't be opened.";
+  else if (status == s21::Table::WRITE_ERROR)
+    reason = QString("Write failed after %1 rows.").arg(rows);
+  QMessageBox::warning(this, "Table", reason);
+}
+
+/* Slot to take samples computed so far. Samples of cancelled requests are
+ * dropped. Points between computed ones are interpolated, so coarse graph is
+ * shown at once and refined on next frames. Samples are written straight into
+ * graph data container, reusing its storage. */
+void Calculator::drainPlot() {
+  bool changed = false;
+  PlotSample sample;
+  while (samples.pop(sample) == true) {
+    if (sample.generation != generation) continue;
+    if (sample.generation != drawn_generation) resetPlot();
+    QVector<bool> &known = exact[sample.graph];
+    (ui->widgetPlot->graph(sample.graph)->data()->begin() + sample.index)
+        ->value = sample.value;
+    if (known[sample.index] == false) received++;
+    known[sample.index] = true;
+    int left = sample.index - sample.stride;
+    int right = sample.index + sample.stride;
+    if (left >= 0) fillGap(sample.graph, left, sample.index);
+    if (sample.stride < PlotWorker::COARSE_STRIDE || right >= plot_size)
+      fillGap(sample.graph, sample.index, right);
+    changed = true;
+  }
+  if (changed == true) ui->widgetPlot->replot();
+  if (drawn_generation == generation && received >= plot_size * plot_graphs)
+    frame_timer.stop();
+}
+
+/* Prepare graph data containers for new request: keys are set, values are
+ * unknown until computed. Keys are ascending, so the containers stay sorted
+ * without any check. */
+void Calculator::resetPlot() {
+  while (ui->widgetPlot->graphCount() > plot_graphs)
+    ui->widgetPlot->removeGraph(ui->widgetPlot->graphCount() - 1);
+  while (ui->widgetPlot->graphCount() < plot_graphs) {
+    QCPGraph *graph = ui->widgetPlot->addGraph();
+    graph->setPen(QPen(
+        GRAPH_COLORS[(ui->widgetPlot->graphCount() - 1) % GRAPH_COLORS.size()],
+        1));
+  }
+  exact.resize(plot_graphs);
+  for (int g = 0; g < plot_graphs; ++g) {
+    QSharedPointer<QCPGraphDataContainer> data =
+        ui->widgetPlot->graph(g)->data();
+    if (data->size() != plot_size)
+      data->set(QVector<QCPGraphData>(plot_size), true);
+    long long i = plot_grid.first;
+    for (QCPGraphDataContainer::iterator it = data->begin();
+         it != data->end(); ++it, ++i) {
+      it->key = s21::SampleCache::Position(plot_grid.level, i);
+      it->value = qQNaN();
+    }
+    exact[g].fill(false, plot_size);
+  }
+  received = 0;
+  drawn_generation = generation;
+}
+
+/* Fill points of graph strictly between 'from' and 'to' that are not computed
+ * yet. Values are interpolated linearly if both ends are computed. If 'to'
+ * lies past the end, value at 'from' is held. */
+void Calculator::fillGap(int graph, int from, int to) {
+  const QVector<bool> &known = exact[graph];
+  QCPGraphDataContainer::iterator begin =
+      ui->widgetPlot->graph(graph)->data()->begin();
+  bool tail = to >= plot_size;
+  if (tail == true) to = plot_size;
+  if (tail == false && (known[from] == false || known[to] == false)) return;
+  double a = (begin + from)->value;
+  double b = tail == true ? a : (begin + to)->value;
+  for (int i = from + 1; i < to; i++) {
+    if (known[i] == true) continue;
+    (begin + i)->value = a + (b - a) * (i - from) / (to - from);
+  }
+}
+
 /* Set radian as measure */
-void Calculator::setRadian() { ctrl.setRadian(); }
+void Calculator::setRadian() {
+  ctrl.setRadian();
+  plotGraph();
+}
 
-void Calculator::setDegree() { ctrl.setDegree(); }
+void Calculator::setDegree() {
+  ctrl.setDegree();
+  plotGraph();
+}
 
 void Calculator::inputLineText() {
   QPushButton *buttonSender = qobject_cast<QPushButton *>(sender());
@@ -252,41 +545,9 @@ void Calculator::backspaceLineText() {
 /* Convert double to QString with formatting.
 Trails all useless zeros, up to 16 digits. */
 QString Calculator::doubleToQString(double value) {
-  QString str = QString::number(value, 'g', 16);
-  if (hasDot(str) && !hasExp(str)) {
-    while (str.back() == '0') {
-      str.chop(1);
-    }
-    if (str.back() == '.') str.chop(1);
-  } else if (hasDot(str) && hasExp(str)) {
-    int exp_pos = findExp(str);
-    while (str[exp_pos - 1] == '0') {
-      str.remove(exp_pos - 1, 1);
-      exp_pos--;
-    }
-  }
-  return str;
-}
-
-int Calculator::findExp(const QString str) {
-  for (int i = 0; i < str.size(); ++i) {
-    if (str[i] == 'e' || str[i] == 'E') return i;
-  }
-  return -1;
-}
-
-bool Calculator::hasDot(const QString str) {
-  for (int i = 0; i < str.size(); ++i) {
-    if (str[i] == '.') return true;
-  }
-  return false;
-}
-
-bool Calculator::hasExp(const QString str) {
-  for (int i = 0; i < str.size(); ++i) {
-    if (str[i] == 'e' || str[i] == 'E') return true;
-  }
-  return false;
+  char buffer[s21::Format::BUFFER_SIZE];
+  return QString::fromLatin1(buffer,
+                             s21::Format::Precise(buffer, value) - buffer);
 }
 
 bool Calculator::isLimitsChanged() {
@@ -2,10 +2,17 @@
 #define CALCULATOR_H
 
 #include <QLineEdit>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
 #include <QWidget>
+#include <atomic>
 
 #include "../controller/s21_controller.h"
+#include "../model/s21_format.h"
+#include "plotworker.h"
 #include "qcustomplot.h"
+#include "tableworker.h"
 
 namespace Ui {
 class Calculator;
@@ -22,12 +29,41 @@ class Calculator : public QWidget {
   void setDefaultSizes();
   void nullDefaultSizes();
 
+ signals:
+  void plotRequested(quint64 generation, QStringList expressions,
+                     bool degree, int level, qint64 first, int count);
+  void curvesRequested(quint64 generation, QStringList expressions,
+                       bool degree, int mode, double scale_x, double scale_y);
+  void heatmapRequested(quint64 generation, QString expression, bool degree,
+                        double min_x, double max_x, int size_x, double min_y,
+                        double max_y, int size_y);
+  void implicitRequested(quint64 generation, QStringList expressions,
+                         bool degree, double min_x, double max_x, double min_y,
+                         double max_y, int cells_x, int cells_y);
+  void integralRequested(quint64 generation, QString expression, bool degree,
+                         double min_x, double max_x);
+  void tableRequested(QString expression, bool degree, double min_x,
+                      double max_x, double step, QString path);
+
  private slots:
   void calculateResult();
+  void previewResult();
   void setRange();
   void changeRangeX(const QCPRange &range);
   void changeRangeY(const QCPRange &range);
   void plotGraph();
+  void drainPlot();
+  void applyCurve(quint64 number, int index, int count, QVector<double> t,
+                  QVector<double> x, QVector<double> y);
+  void applyHeatmap(quint64 number, double lower_x, double upper_x,
+                    int size_x, double lower_y, double upper_y, int size_y,
+                    QVector<double> values);
+  void applyIntegral(quint64 number, double lower, double upper, double value,
+                     double error, bool valid);
+  void setPlotMode(int mode);
+  void exportTable();
+  void showTableProgress(int percent);
+  void finishTable(int status, qint64 rows);
 
   void setDegree();
   void setRadian();
@@ -46,17 +82,50 @@ class Calculator : public QWidget {
 
   double min_x = 0.0, max_x = 0.0, min_y = 0.0, max_y = 0.0;
   int size;
-  QVector<double> x{NAN}, y{NAN};
+
+  /* Graph samples are computed by worker in plot_thread. Each plot request
+   * increments generation, which cancels all previous requests. */
+  std::atomic<quint64> generation{0};
+  QThread plot_thread;
+  PlotWorker *worker = nullptr;
+
+  /* Samples are passed through lock-free buffer and drained once per frame.
+   * 'exact' marks points of every graph that hold computed values, others
+   * are interpolated from neighbours until refinement reaches them. */
+  const int FRAME_INTERVAL = 16;
+  PlotBuffer samples;
+  QTimer frame_timer;
+  quint64 drawn_generation = 0;
+  s21::SampleCache::Grid plot_grid;
+  int plot_size = 0, plot_graphs = 1, received = 0;
+  QVector<QVector<bool>> exact;
+  const QVector<QColor> GRAPH_COLORS = {
+      Qt::black, QColor(200, 40, 40), QColor(30, 90, 200),
+      QColor(20, 140, 60), QColor(170, 80, 190), QColor(220, 130, 20)};
+
+  /* Parametric and polar curves, computed whole and set at once. */
+  PlotMode plot_mode = FUNCTION;
+  QVector<QCPCurve *> curves;
+  QCPColorMap *color_map = nullptr;
+  /* Size of coarse cell of implicit curve tracing in pixels. */
+  const int IMPLICIT_CELL = 16;
+
+  /* Table export runs in its own thread, button cancels it while running. */
+  QThread table_thread;
+  TableWorker *table_worker = nullptr;
+  std::atomic<bool> table_cancelled{false};
+  bool table_running = false;
+
+  void resetPlot();
+  void fillGap(int graph, int from, int to);
 
   /* Initial set */
+  void initializeWorker();
   void initializeGraph();
   void connectSignals();
 
   /* Misc */
   QString doubleToQString(double value);
-  bool hasDot(const QString str);
-  bool hasExp(const QString str);
-  int findExp(const QString str);
   bool isLimitsChanged();
   QString appendLeftPar(const QString str);
 };
@@ -64,48 +64,41 @@ void CreditCalculator::fillTable() {
         i, 0,
         new QTableWidgetItem(getDateString(ctrl.getMonth(i), ctrl.getYear(i))));
     ui->tableWidgetCredit->setItem(
-        i, 1,
-        new QTableWidgetItem(QString::number(ctrl.getPayment(i), 'f', 2)));
+        i, 1, new QTableWidgetItem(moneyString(ctrl.getPayment(i))));
     ui->tableWidgetCredit->setItem(
-        i, 2,
-        new QTableWidgetItem(QString::number(ctrl.getMainPart(i), 'f', 2)));
+        i, 2, new QTableWidgetItem(moneyString(ctrl.getMainPart(i))));
     ui->tableWidgetCredit->setItem(
-        i, 3,
-        new QTableWidgetItem(QString::number(ctrl.getRatePart(i), 'f', 2)));
+        i, 3, new QTableWidgetItem(moneyString(ctrl.getRatePart(i))));
     ui->tableWidgetCredit->setItem(
-        i, 4,
-        new QTableWidgetItem(QString::number(ctrl.getLeftover(i), 'f', 2)));
+        i, 4, new QTableWidgetItem(moneyString(ctrl.getLeftover(i))));
   }
   ui->tableWidgetCredit->setItem(ctrl.getDataSize(), 0,
                                  new QTableWidgetItem("Total:"));
   ui->tableWidgetCredit->setItem(
       ctrl.getDataSize(), 1,
-      new QTableWidgetItem(QString::number(ctrl.getSumPaid(), 'f', 2) +
-                           "\nTotal paid"));
+      new QTableWidgetItem(moneyString(ctrl.getSumPaid()) + "\nTotal paid"));
   ui->tableWidgetCredit->setItem(
       ctrl.getDataSize(), 2,
-      new QTableWidgetItem(QString::number(ctrl.getSumMainPart(), 'f', 2) +
-                           "\nDebt paid"));
+      new QTableWidgetItem(moneyString(ctrl.getSumMainPart()) + "\nDebt paid"));
   ui->tableWidgetCredit->setItem(
       ctrl.getDataSize(), 3,
-      new QTableWidgetItem(QString::number(ctrl.getSumRatePart(), 'f', 2) +
+      new QTableWidgetItem(moneyString(ctrl.getSumRatePart()) +
                            "\nInterest paid"));
   ui->tableWidgetCredit->resizeRowsToContents();
 }
 
 void CreditCalculator::fillLines() {
   if (ctrl.isAnnuity() == true)
-    ui->lineEditPayment->setText(QString::number(ctrl.getPayment(0), 'f', 2));
+    ui->lineEditPayment->setText(moneyString(ctrl.getPayment(0)));
   else if (ctrl.isDifferential() == true) {
-    ui->lineEditPayment->setText(QString::number(ctrl.getPayment(0), 'f', 2));
+    ui->lineEditPayment->setText(moneyString(ctrl.getPayment(0)));
     if (ctrl.getDataSize() > 1)
       ui->lineEditPayment->insert(
-          "-" +
-          QString::number(ctrl.getPayment(ctrl.getDataSize() - 1), 'f', 2));
+          "-" + moneyString(ctrl.getPayment(ctrl.getDataSize() - 1)));
   }
-  ui->lineEditInterest->setText(QString::number(ctrl.getSumRatePart(), 'f', 2));
+  ui->lineEditInterest->setText(moneyString(ctrl.getSumRatePart()));
   ui->lineEditTotal->setText(
-      QString::number(ctrl.getSumRatePart() + ctrl.getSumMainPart(), 'f', 2));
+      moneyString(ctrl.getSumRatePart() + ctrl.getSumMainPart()));
 }
 
 void CreditCalculator::clearContent() {
@@ -159,3 +152,9 @@ void CreditCalculator::limitTime(int index) {
 QString CreditCalculator::getDateString(int month, int year) {
   return MONTHS[month - 1] + " " + QString::number(year);
 }
+
+QString CreditCalculator::moneyString(double value) {
+  char buffer[s21::Format::BUFFER_SIZE];
+  return QString::fromLatin1(buffer,
+                             s21::Format::Money(buffer, value) - buffer);
+}
@@ -4,6 +4,7 @@
 #include <QWidget>
 
 #include "../controller/s21_controller_credit.h"
+#include "../model/s21_format.h"
 
 namespace Ui {
 class CreditCalculator;
@@ -44,6 +45,7 @@ class CreditCalculator : public QWidget {
   void setData();
   int getTime();
   QString getDateString(int month, int year);
+  static QString moneyString(double value);
 };
 
 #endif  // CREDITCALCULATOR_H
@@ -178,7 +178,7 @@ void DepositCalculator::fillTable() {
           ui->tableWidgetEvents->setItem(
               ui->tableWidgetEvents->rowCount() - 1, 1,
               new QTableWidgetItem(outputNumber(
-                  data.getEventListElement(i)->gain(), false, 'f', 2)));
+                  data.getEventListElement(i)->gain(), false)));
         if (data.getEventListElement(i)->event() != s21::Deposit::E_PAYDAY ||
             (data.getEventListElement(i)->event() == s21::Deposit::E_PAYDAY &&
              data.isCapitalization() == true))
@@ -186,17 +186,17 @@ void DepositCalculator::fillTable() {
               ui->tableWidgetEvents->rowCount() - 1, 2,
               new QTableWidgetItem(
                   outputNumber(data.getEventListElement(i)->balance_change(),
-                               true, 'f', 2)));
+                               true)));
         if (data.getEventListElement(i)->event() == s21::Deposit::E_PAYDAY &&
             data.isCapitalization() == false)
           ui->tableWidgetEvents->setItem(
               ui->tableWidgetEvents->rowCount() - 1, 3,
               new QTableWidgetItem(outputNumber(
-                  data.getEventListElement(i)->payment(), false, 'f', 2)));
+                  data.getEventListElement(i)->payment(), false)));
         ui->tableWidgetEvents->setItem(
             ui->tableWidgetEvents->rowCount() - 1, 4,
             new QTableWidgetItem(outputNumber(
-                data.getEventListElement(i)->balance(), false, 'f', 2)));
+                data.getEventListElement(i)->balance(), false)));
         ui->tableWidgetEvents->setItem(
             ui->tableWidgetEvents->rowCount() - 1, 5,
             new QTableWidgetItem(
@@ -207,9 +207,9 @@ void DepositCalculator::fillTable() {
             new QTableWidgetItem(
                 "Withdrawal (" +
                 outputNumber(data.getEventListElement(i)->balance_change(),
-                             false, 'f', 2) +
+                             false) +
                 ") was declined due to minimum balance limit (" +
-                outputNumber(data.getRemainderLimit(), false, 'f', 2) + ")"));
+                outputNumber(data.getRemainderLimit(), false) + ")"));
         ui->tableWidgetEvents->setSpan(ui->tableWidgetEvents->rowCount() - 1, 1,
                                        1,
                                        5);
@@ -221,10 +221,10 @@ void DepositCalculator::fillTable() {
                                  new QTableWidgetItem("Total:"));
   ui->tableWidgetEvents->setItem(ui->tableWidgetEvents->rowCount() - 1, 1,
                                  new QTableWidgetItem(outputNumber(
-                                     data.getInterestTotal(), false, 'f', 2)));
+                                     data.getInterestTotal(), false)));
   ui->tableWidgetEvents->setItem(
       ui->tableWidgetEvents->rowCount() - 1, 4,
-      new QTableWidgetItem(outputNumber(data.getBalance(), false, 'f', 2)));
+      new QTableWidgetItem(outputNumber(data.getBalance(), false)));
   ui->tableWidgetEvents->resizeRowsToContents();
 }
 
@@ -237,11 +237,11 @@ void DepositCalculator::fillTaxes() {
     ui->tableWidgetTax->setItem(
         i, 1,
         new QTableWidgetItem(
-            outputNumber(data.getTaxListElement(i)->income(), false, 'f', 2)));
+            outputNumber(data.getTaxListElement(i)->income(), false)));
     ui->tableWidgetTax->setItem(
         i, 2,
         new QTableWidgetItem(
-            outputNumber(data.getTaxListElement(i)->tax(), false, 'f', 2)));
+            outputNumber(data.getTaxListElement(i)->tax(), false)));
   }
   ui->tableWidgetTax->resizeRowsToContents();
 }
@@ -258,8 +258,9 @@ void DepositCalculator::clearContent() {
 }
 
 QString DepositCalculator::getDateString(s21::Date date) {
-  QDate qdate(date.getYear(), date.getMonth(), date.getDay());
-  return qdate.toString("dd.MM.yyyy");
+  char buffer[s21::Date::FORMAT_SIZE];
+  date.format(buffer);
+  return QString::fromLatin1(buffer);
 }
 
 QString DepositCalculator::getEventString(s21::Deposit::EventType event) {
@@ -327,7 +328,7 @@ void DepositCalculator::addReplenish() {
   ui->tableWidgetReplenishes->setItem(
       ui->tableWidgetReplenishes->rowCount() - 1, 2,
       new QTableWidgetItem(
-          outputNumber(ui->doubleSpinBoxValue->value(), false, 'f', 2)));
+          outputNumber(ui->doubleSpinBoxValue->value(), false)));
   ui->tableWidgetReplenishes->selectRow(ui->tableWidgetReplenishes->rowCount() -
                                         1);
   ui->tableWidgetReplenishes->resizeRowsToContents();
@@ -367,7 +368,7 @@ void DepositCalculator::addWithdrawal() {
   ui->tableWidgetWithdrawals->setItem(
       ui->tableWidgetWithdrawals->rowCount() - 1, 2,
       new QTableWidgetItem(
-          outputNumber(ui->doubleSpinBoxValue->value(), false, 'f', 2)));
+          outputNumber(ui->doubleSpinBoxValue->value(), false)));
   ui->tableWidgetWithdrawals->selectRow(ui->tableWidgetWithdrawals->rowCount() -
                                         1);
   ui->tableWidgetWithdrawals->resizeRowsToContents();
@@ -409,16 +410,14 @@ void DepositCalculator::setCapitalization(int value) {
 
 void DepositCalculator::fillSummary() {
   ui->lineEditAccruedInterest->setText(
-      outputNumber(data.getInterestTotal(), false, 'f', 2));
+      outputNumber(data.getInterestTotal(), false));
   ui->lineEditTotal->setText(outputNumber(
       data.getInterestTotal() + data.getDeposit() + data.getReplenishTotal(),
-      false, 'f', 2));
+      false));
   ui->lineEditGain->setText(
-      outputNumber(data.getInterestTotal() / data.getDeposit() * 100.0, false,
-                   'f', 2) +
+      outputNumber(data.getInterestTotal() / data.getDeposit() * 100.0, false) +
       " %");
-  ui->lineEditTotalTax->setText(
-      outputNumber(data.getTaxTotal(), false, 'f', 2));
+  ui->lineEditTotalTax->setText(outputNumber(data.getTaxTotal(), false));
 }
 
 void DepositCalculator::setInitialState() {
@@ -451,63 +450,16 @@ void DepositCalculator::setInitialState() {
   ui->dateEditOperationDate->setMinimumDate(QDate(MIN_START_YEAR, 1, 1));
 }
 
-QString DepositCalculator::outputNumber(double number, bool force_plus,
-                                        char format, int decimal_digits) {
-  QString ret =
-      removeTrailingZeros(QString::number(number, format, decimal_digits));
-  if (isAllZeros(ret) == true) {
-    if (force_plus == true)
-      return QString();
-    else
-      return QString("0");
-  }
-  if (force_plus == true && number > 0.0) {
-    ret.insert(0, '+');
-  }
-  return ret;
-}
-
-QString DepositCalculator::removeTrailingZeros(QString number,
-                                               bool scientific) {
-  QString ret;
-  bool flag = false;
-  if (scientific == true) {
-    for (QString::const_reverse_iterator i = number.crbegin();
-         i != number.crend(); ++i) {
-      if (flag == true && *i == QChar('0'))
-        continue;
-      else if (*i == QChar('e') || *i == QChar('E'))
-        flag = true;
-      else if (flag == true && *i != QChar('0'))
-        flag = false;
-      ret.insert(0, *i);
-    }
-  } else {
-    if (number.contains(QChar(',')) == true ||
-        number.contains(QChar('.')) == true) {
-      for (QString::const_reverse_iterator i = number.crbegin();
-           i != number.crend(); ++i) {
-        if (flag == false && *i == QChar('0'))
-          continue;
-        else if (flag == false && (*i == QChar(',') || *i == QChar('.'))) {
-          flag = true;
-          continue;
-        } else if (flag == false && *i != QChar('0')) {
-          flag = true;
-        }
-        ret.insert(0, *i);
-      }
-    }
-  }
-  return ret;
-}
-
-bool DepositCalculator::isAllZeros(QString number) {
-  for (QString::const_reverse_iterator i = number.crbegin();
-       i != number.crend(); ++i) {
-    if (*i != QChar(',') && *i != QChar('0')) return false;
-  }
-  return true;
+/* Money with two decimals and without trailing zeros. Zero is "0", or empty
+ * if plus sign is forced. */
+QString DepositCalculator::outputNumber(double number, bool force_plus) {
+  char buffer[s21::Format::BUFFER_SIZE + 1];
+  char *first = buffer + 1;
+  char *last = s21::Format::Money(first, number, true);
+  if (last - first == 1 && *first == '0')
+    return force_plus == true ? QString() : QString("0");
+  if (force_plus == true && number > 0.0) *--first = '+';
+  return QString::fromLatin1(first, last - first);
 }
 
 /* void DepositCalculator::mousePressEvent(QMouseEvent *event) {
@@ -6,6 +6,7 @@
 #include <QWidget>
 
 #include "../controller/s21_controller_deposit.h"
+#include "../model/s21_format.h"
 
 namespace Ui {
 class DepositCalculator;
@@ -73,10 +74,7 @@ class DepositCalculator : public QWidget {
   QString getDateString(s21::Date date);
   QString getEventString(s21::Deposit::EventType event);
   QString getOperPeriodString(s21::Deposit::OperPeriod period);
-  static QString outputNumber(double number, bool force_plus = false,
-                              char format = 'f', int decimal_digits = '2');
-  static QString removeTrailingZeros(QString number, bool scientific = false);
-  static bool isAllZeros(QString number);
+  static QString outputNumber(double number, bool force_plus = false);
 };
 
 #endif  // DEPOSITCALCULATOR_H
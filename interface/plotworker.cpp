@@ -0,0 +1,254 @@
+#include "plotworker.h"
+
+#include <QThread>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+PlotWorker::PlotWorker(const std::atomic<quint64> &generation,
+                       PlotBuffer &buffer, QObject *parent)
+    : QObject(parent), current(generation), samples(buffer) {}
+
+/* Slot to compute graph values for 'count' points of grid 'level' starting
+ * from point 'first'. The first pass takes every COARSE_STRIDE-th point, each
+ * next pass fills the middles between already computed points. Stops as soon
+ * as request is cancelled. */
+void PlotWorker::compute(quint64 generation, QStringList expressions,
+                         bool degree, int level, qint64 first, int count) {
+  if (isCancelled(generation) == true) return;
+  int graphs = expressions.size();
+  if (ctrls.size() < static_cast<size_t>(graphs)) ctrls.resize(graphs);
+  std::vector<std::string> texts(graphs);
+  std::vector<bool> valid(graphs);
+  for (int g = 0; g < graphs; ++g) {
+    texts[g] = expressions[g].toStdString();
+    if (degree == true)
+      ctrls[g].setDegree();
+    else
+      ctrls[g].setRadian();
+    valid[g] = ctrls[g].prepare(texts[g]);
+  }
+  std::vector<int> indexes;
+  std::vector<double> values;
+  for (int stride = COARSE_STRIDE; stride > 0; stride /= 2) {
+    int start = stride == COARSE_STRIDE ? 0 : stride;
+    int skip = stride == COARSE_STRIDE ? stride : 2 * stride;
+    for (int i = start; i < count;) {
+      if (isCancelled(generation) == true) return;
+      indexes.clear();
+      for (; i < count && static_cast<int>(indexes.size()) < BLOCK_SIZE;
+           i += skip)
+        indexes.push_back(i);
+      for (int g = 0; g < graphs; ++g) {
+        values.assign(indexes.size(), qQNaN());
+        if (valid[g] == true) {
+          cache.SetFunction(texts[g], degree);
+          evaluate(g, level, first, indexes, values);
+        }
+        for (size_t k = 0; k < indexes.size(); ++k) {
+          PlotSample sample{generation, g, indexes[k], stride, values[k]};
+          if (send(sample) == false) return;
+        }
+      }
+    }
+  }
+}
+
+/* Take block of points from cache, points that are not there are calculated
+ * with one call. */
+void PlotWorker::evaluate(int graph, int level, qint64 first,
+                          const std::vector<int> &indexes,
+                          std::vector<double> &values) {
+  std::vector<size_t> missed;
+  std::vector<double> x;
+  for (size_t k = 0; k < indexes.size(); ++k) {
+    if (cache.Find(level, first + indexes[k], values[k]) == true) continue;
+    missed.push_back(k);
+    x.push_back(s21::SampleCache::Position(level, first + indexes[k]));
+  }
+  if (missed.empty() == true) return;
+  std::vector<double> y(x.size());
+  if (ctrls[graph].calculate(x.data(), y.data(), x.size()) == false) return;
+  for (size_t m = 0; m < missed.size(); ++m) {
+    values[missed[m]] = y[m];
+    cache.Store(level, first + indexes[missed[m]], y[m]);
+  }
+}
+
+/* Slot to compute curves of parametric or polar mode. Parameter runs over
+ * one full turn: [0, 2π] in radians or [0, 360] in degrees. Scales are sizes
+ * of one pixel along axes, curves are refined up to pixel level. */
+void PlotWorker::computeCurves(quint64 generation, QStringList expressions,
+                               bool degree, int mode, double scale_x,
+                               double scale_y) {
+  if (isCancelled(generation) == true) return;
+  int components = mode == PARAMETRIC ? 2 : 1;
+  int curves = expressions.size() / components;
+  if (ctrls.size() < static_cast<size_t>(expressions.size()))
+    ctrls.resize(expressions.size());
+  std::vector<bool> valid(expressions.size());
+  for (int i = 0; i < expressions.size(); ++i) {
+    if (degree == true)
+      ctrls[i].setDegree();
+    else
+      ctrls[i].setRadian();
+    valid[i] = ctrls[i].prepare(expressions[i].toStdString());
+  }
+  s21::CurveSampler::Options options;
+  options.scale_x = scale_x;
+  options.scale_y = scale_y;
+  s21::CurveSampler sampler(options);
+  double t_max = degree == true ? 360.0 : 2 * M_PI;
+  if (curves == 0) emit curveComputed(generation, -1, 0, {}, {}, {});
+  for (int c = 0; c < curves; ++c) {
+    int first = c * components;
+    std::vector<s21::CurveSampler::Point> points = sampler.Sample(
+        [&](const double *t, double *x, double *y, size_t count) {
+          if (isCancelled(generation) == true) return false;
+          evaluateCurve(first, valid[first], t, x, count);
+          if (mode == PARAMETRIC) {
+            evaluateCurve(first + 1, valid[first + 1], t, y, count);
+            return true;
+          }
+          for (size_t i = 0; i < count; ++i) {
+            double angle = degree == true ? qDegreesToRadians(t[i]) : t[i];
+            y[i] = x[i] * std::sin(angle);
+            x[i] = x[i] * std::cos(angle);
+          }
+          return true;
+        },
+        0.0, t_max);
+    if (isCancelled(generation) == true) return;
+    QVector<double> t(points.size()), x(points.size()), y(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      t[i] = points[i].t;
+      x[i] = points[i].x;
+      y[i] = points[i].y;
+    }
+    emit curveComputed(generation, c, curves, t, x, y);
+  }
+}
+
+/* Slot to compute heatmap of f(x, y). Tiles that are not in cache are
+ * evaluated in parallel, calculation of prepared expression does not change
+ * controller, so it is shared by all threads. */
+void PlotWorker::computeHeatmap(quint64 generation, QString expression,
+                                bool degree, double min_x, double max_x,
+                                int size_x, double min_y, double max_y,
+                                int size_y) {
+  if (isCancelled(generation) == true) return;
+  if (ctrls.empty() == true) ctrls.resize(1);
+  const s21::Controller &ctrl = ctrls[0];
+  if (degree == true)
+    ctrls[0].setDegree();
+  else
+    ctrls[0].setRadian();
+  bool valid = ctrls[0].prepare(expression.toStdString());
+  s21::SurfaceCache::Grid grid = s21::SurfaceCache::MakeGrid(
+      min_x, max_x, size_x, min_y, max_y, size_y);
+  QVector<double> values(grid.x.count * grid.y.count, qQNaN());
+  if (valid == true) {
+    surfaces.SetFunction(expression.toStdString(), degree);
+    bool completed = surfaces.Fill(
+        grid,
+        [&](const double *x, const double *y, double *z, size_t count) {
+          if (isCancelled(generation) == true) return false;
+          if (ctrl.calculate(x, y, z, count) == false)
+            std::fill(z, z + count, qQNaN());
+          return true;
+        },
+        values.data());
+    if (completed == false) return;
+  }
+  emit heatmapComputed(
+      generation, s21::SampleCache::Position(grid.x.level, grid.x.first),
+      s21::SampleCache::Position(grid.x.level,
+                                 grid.x.first + grid.x.count - 1),
+      grid.x.count, s21::SampleCache::Position(grid.y.level, grid.y.first),
+      s21::SampleCache::Position(grid.y.level,
+                                 grid.y.first + grid.y.count - 1),
+      grid.y.count, values);
+}
+
+/* Slot to trace curves f(x, y) = 0, one per expression. Segments are put
+ * into one curve, separated by NaN points. */
+void PlotWorker::computeImplicit(quint64 generation, QStringList expressions,
+                                 bool degree, double min_x, double max_x,
+                                 double min_y, double max_y, int cells_x,
+                                 int cells_y) {
+  if (isCancelled(generation) == true) return;
+  if (ctrls.size() < static_cast<size_t>(expressions.size()))
+    ctrls.resize(expressions.size());
+  s21::ImplicitCurve::Options options;
+  options.cells_x = cells_x;
+  options.cells_y = cells_y;
+  s21::ImplicitCurve tracer(options);
+  std::vector<s21::ImplicitCurve::Segment> segments;
+  for (int c = 0; c < expressions.size(); ++c) {
+    s21::Controller &ctrl = ctrls[c];
+    if (degree == true)
+      ctrl.setDegree();
+    else
+      ctrl.setRadian();
+    segments.clear();
+    if (ctrl.prepare(s21::ImplicitCurve::ToZeroForm(
+            expressions[c].toStdString())) == true) {
+      bool completed = tracer.Trace(
+          [&](const double *x, const double *y, double *z, size_t count) {
+            if (isCancelled(generation) == true) return false;
+            if (ctrl.calculate(x, y, z, count) == false)
+              std::fill(z, z + count, qQNaN());
+            return true;
+          },
+          min_x, max_x, min_y, max_y, segments);
+      if (completed == false) return;
+    }
+    QVector<double> t, x, y;
+    for (const s21::ImplicitCurve::Segment &segment : segments) {
+      x << segment.x1 << segment.x2 << qQNaN();
+      y << segment.y1 << segment.y2 << qQNaN();
+    }
+    for (int i = 0; i < x.size(); ++i) t << i;
+    emit curveComputed(generation, c, expressions.size(), t, x, y);
+  }
+}
+
+/* Slot to integrate the first function over x range. Its controller is
+ * already prepared by the plot request, so expression is not parsed again.
+ * Integration stops as soon as a newer request is made. */
+void PlotWorker::computeIntegral(quint64 generation, QString expression,
+                                 bool degree, double min_x, double max_x) {
+  if (isCancelled(generation) == true) return;
+  if (ctrls.empty() == true) ctrls.resize(1);
+  if (degree == true)
+    ctrls[0].setDegree();
+  else
+    ctrls[0].setRadian();
+  double value = qQNaN(), error = qQNaN();
+  bool valid = ctrls[0].prepare(expression.toStdString()) == true &&
+               ctrls[0].integrate(min_x, max_x, value, error, [&]() {
+                 return isCancelled(generation) == false;
+               }) == true;
+  if (isCancelled(generation) == true) return;
+  emit integralComputed(generation, min_x, max_x, value, error, valid);
+}
+
+/* Calculate one component of curve, invalid expression gives gaps. */
+void PlotWorker::evaluateCurve(int ctrl, bool valid, const double *t,
+                               double *values, size_t count) {
+  if (valid == false || ctrls[ctrl].calculate(t, values, count) == false)
+    std::fill(values, values + count, qQNaN());
+}
+
+/* Wait for free space in buffer. Return false if request was cancelled. */
+bool PlotWorker::send(const PlotSample &sample) {
+  while (samples.push(sample) == false) {
+    if (isCancelled(sample.generation) == true) return false;
+    QThread::usleep(FULL_BUFFER_WAIT);
+  }
+  return true;
+}
+
+bool PlotWorker::isCancelled(quint64 generation) const {
+  return generation != current.load(std::memory_order_relaxed);
+}
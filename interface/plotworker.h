@@ -0,0 +1,104 @@
+#ifndef PLOTWORKER_H
+#define PLOTWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <vector>
+
+#include "../controller/s21_controller.h"
+#include "../model/s21_curve_sampler.h"
+#include "../model/s21_implicit_curve.h"
+#include "../model/s21_ring_buffer.h"
+#include "../model/s21_sample_cache.h"
+#include "../model/s21_surface_cache.h"
+
+/* One computed graph point. Stride is the distance to the nearest points
+ * computed on the same or coarser refinement pass. */
+struct PlotSample {
+  quint64 generation = 0;
+  int graph = 0;
+  int index = 0;
+  int stride = 0;
+  double value = 0.0;
+};
+
+typedef s21::RingBuffer<PlotSample, 8192> PlotBuffer;
+
+/* FUNCTION plots y = f(x). PARAMETRIC takes expressions by pairs x(t); y(t),
+ * POLAR takes r(θ). In curve modes variable x of expression is the
+ * parameter. HEATMAP shows f(x, y) of the first expression in color.
+ * IMPLICIT draws curves f(x, y) = 0, expression may be an equation a = b. */
+enum PlotMode { FUNCTION, PARAMETRIC, POLAR, HEATMAP, IMPLICIT };
+
+/* Computes graph samples in a separate thread. Every request carries
+ * generation number; request is dropped as soon as generation counter owned
+ * by widget moves forward, i.e. newer request was made. Samples are produced
+ * progressively: every COARSE_STRIDE-th point first, then halving stride until
+ * full resolution, and are passed to widget through lock-free buffer. Points
+ * lie on power-of-two grids of SampleCache, so only points that were not
+ * computed before are evaluated. All graphs of request share one pass over x:
+ * points are taken in blocks of BLOCK_SIZE, and each expression is evaluated
+ * for the whole block at once. Curves of parametric and polar modes are
+ * sampled adaptively and sent with one signal per curve, or with one empty
+ * signal if there are no curves. Heatmap is evaluated by tiles on all cores
+ * and sent whole. Implicit curves are traced by marching squares and sent as
+ * curves of separate segments. Integral of the first function over x range is
+ * computed after its graph. */
+class PlotWorker : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit PlotWorker(const std::atomic<quint64> &generation,
+                      PlotBuffer &buffer, QObject *parent = nullptr);
+  ~PlotWorker() = default;
+
+  static constexpr int COARSE_STRIDE = 8;
+  static constexpr int BLOCK_SIZE = 64;
+
+ signals:
+  void curveComputed(quint64 generation, int index, int count,
+                     QVector<double> t, QVector<double> x, QVector<double> y);
+  void heatmapComputed(quint64 generation, double min_x, double max_x,
+                       int size_x, double min_y, double max_y, int size_y,
+                       QVector<double> values);
+  void integralComputed(quint64 generation, double min_x, double max_x,
+                        double value, double error, bool valid);
+
+ public slots:
+  void compute(quint64 generation, QStringList expressions, bool degree,
+               int level, qint64 first, int count);
+  void computeCurves(quint64 generation, QStringList expressions, bool degree,
+                     int mode, double scale_x, double scale_y);
+  void computeHeatmap(quint64 generation, QString expression, bool degree,
+                      double min_x, double max_x, int size_x, double min_y,
+                      double max_y, int size_y);
+  void computeImplicit(quint64 generation, QStringList expressions,
+                       bool degree, double min_x, double max_x, double min_y,
+                       double max_y, int cells_x, int cells_y);
+  void computeIntegral(quint64 generation, QString expression, bool degree,
+                       double min_x, double max_x);
+
+ private:
+  const std::atomic<quint64> &current;
+  PlotBuffer &samples;
+  /* One controller per graph, so every expression stays parsed. */
+  std::vector<s21::Controller> ctrls;
+  /* Samples computed for previous requests, reused on pan and zoom. */
+  s21::SampleCache cache;
+  s21::SurfaceCache surfaces;
+
+  /* Pause in microseconds when buffer is full. */
+  const unsigned long FULL_BUFFER_WAIT = 200;
+
+  void evaluate(int graph, int level, qint64 first,
+                const std::vector<int> &indexes, std::vector<double> &values);
+  void evaluateCurve(int ctrl, bool valid, const double *t, double *values,
+                     size_t count);
+  bool send(const PlotSample &sample);
+  bool isCancelled(quint64 generation) const;
+};
+
+#endif  // PLOTWORKER_H
@@ -0,0 +1,37 @@
+#include "tableworker.h"
+
+TableWorker::TableWorker(const std::atomic<bool> &cancel, QObject *parent)
+    : QObject(parent), cancelled(cancel) {}
+
+/* Slot to write table of x from min_x to max_x with step. File with .bin
+ * suffix gets binary rows, any other gets CSV. Output is mapped into memory,
+ * so table of any size is written without holding it. */
+void TableWorker::write(QString expression, bool degree, double min_x,
+                        double max_x, double step, QString path) {
+  if (degree == true)
+    ctrl.setDegree();
+  else
+    ctrl.setRadian();
+  unsigned long long total = s21::Table::Rows(min_x, max_x, step);
+  unsigned long long done = 0;
+  int percent = -1;
+  s21::Table::Options options;
+  options.output = s21::Table::MAPPED;
+  if (path.endsWith(".bin", Qt::CaseInsensitive) == true)
+    options.format = s21::Dataset::BINARY;
+  s21::Table::Status status = s21::Table::CALCULATE_ERROR;
+  if (ctrl.prepare(expression.toStdString()) == true) {
+    status = ctrl.writeTable(
+        min_x, max_x, step, path.toStdString(), options,
+        [&](unsigned long long rows) {
+          done = rows;
+          int current = static_cast<int>(rows * 100 / total);
+          if (current != percent) {
+            percent = current;
+            emit progressed(percent);
+          }
+          return cancelled.load(std::memory_order_relaxed) == false;
+        });
+  }
+  emit written(status, static_cast<qint64>(done));
+}
@@ -0,0 +1,34 @@
+#ifndef TABLEWORKER_H
+#define TABLEWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+
+#include "../controller/s21_controller.h"
+
+/* Writes table of expression values to file in a separate thread, so long
+ * tables do not hold plot worker. Writing is stopped as soon as flag owned by
+ * widget is set. Progress is reported by whole percents. */
+class TableWorker : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit TableWorker(const std::atomic<bool> &cancel,
+                       QObject *parent = nullptr);
+  ~TableWorker() = default;
+
+ signals:
+  void progressed(int percent);
+  void written(int status, qint64 rows);
+
+ public slots:
+  void write(QString expression, bool degree, double min_x, double max_x,
+             double step, QString path);
+
+ private:
+  const std::atomic<bool> &cancelled;
+  s21::Controller ctrl;
+};
+
+#endif  // TABLEWORKER_H
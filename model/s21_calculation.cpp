@@ -1,8 +1,49 @@
 #include "s21_calculation.h"
 
+#include <chrono>
+
 namespace s21 {
 
+namespace {
+
+#ifdef S21_CALCULATION_STATS
+constexpr bool STATS_ENABLED = true;
+#else
+constexpr bool STATS_ENABLED = false;
+#endif
+
+/* Adds time spent in the scope and one call to the phase counters. Has no
+ * members and does nothing when statistics are disabled. */
+template <bool Enabled>
+class PhaseTimer {
+ public:
+  PhaseTimer(unsigned long long&, unsigned long long&) noexcept {}
+};
+
+template <>
+class PhaseTimer<true> {
+ public:
+  PhaseTimer(unsigned long long& ns, unsigned long long& calls) noexcept
+      : ns_(ns), start_(std::chrono::steady_clock::now()) {
+    ++calls;
+  }
+  ~PhaseTimer() {
+    ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start_)
+               .count();
+  }
+
+ private:
+  unsigned long long& ns_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+using StatsTimer = PhaseTimer<STATS_ENABLED>;
+
+}  // namespace
+
 void Calculation::SetX(double x) noexcept { x_ = x; }
+void Calculation::SetY(double y) noexcept { y_ = y; }
 void Calculation::SetX(const std::string& x_str) noexcept {
   double x = NAN;
   int shift = 0;
@@ -18,20 +59,25 @@ void Calculation::SetX(const std::string& x_str) noexcept {
 void Calculation::SetExpression(const std::string& input) noexcept {
   expr_ = input;
   status_ = NEW_EXPRESSION;
+  resume_ = false;
+}
+void Calculation::UpdateExpression(const std::string& input) noexcept {
+  expr_ = input;
+  status_ = NEW_EXPRESSION;
+  resume_ = true;
 }
 void Calculation::SetRadian() noexcept { trig_value_ = RAD; }
 void Calculation::SetDegree() noexcept { trig_value_ = DEG; }
 
 double Calculation::GetX() const noexcept { return x_; }
+double Calculation::GetY() const noexcept { return y_; }
 const std::string Calculation::GetExpression() const noexcept { return expr_; }
 Calculation::TrigType Calculation::GetTrigValue() const noexcept {
   return trig_value_;
 }
 Calculation::Status Calculation::GetStatus() const noexcept { return status_; }
 double Calculation::GetResult() {
-  if (status_ == NEW_EXPRESSION) Reset();
-  if (status_ == READY) Parse();
-  if (status_ == PARSED || status_ == COMPLETED) Calculate();
+  if (Compile() == true) Calculate();
   return result_;
 }
 double Calculation::GetResult(double x) {
@@ -51,52 +97,101 @@ double Calculation::GetResult(const std::string& input, const std::string& x) {
   return GetResult(input);
 }
 
+bool Calculation::Compile() {
+  if (status_ == NEW_EXPRESSION && resume_ == true)
+    Rewind();
+  else if (status_ == NEW_EXPRESSION)
+    Reset();
+  if (status_ == READY) Parse();
+  return status_ == PARSED || status_ == COMPLETED;
+}
+
+/* Evaluation stack holds a block of 'count' values on every level, so each
+ * token is dispatched once per block instead of once per value. */
+bool Calculation::GetResults(const double* x, double* results,
+                             size_t count) const {
+  return GetResults(x, nullptr, results, count);
+}
+
+bool Calculation::GetResults(const double* x, const double* y,
+                             double* results, size_t count) const {
+  if (status_ != PARSED && status_ != COMPLETED) return false;
+  std::vector<double> stack;
+  size_t depth = 0;
+  for (const Token& token : output_queue_) {
+    if (token.type == NUM || IsVariable(token.type)) {
+      stack.resize((depth + 1) * count);
+      double* top = stack.data() + depth * count;
+      const double* variable = token.type == X ? x : y;
+      if (token.type == NUM || variable == nullptr)
+        std::fill(top, top + count, token.type == NUM ? token.number : NAN);
+      else
+        std::copy(variable, variable + count, top);
+      depth++;
+    } else if (IsFunction(token.type) || IsUnaryOperator(token.type)) {
+      if (depth == 0) return false;
+      ApplyUnary(token.type, stack.data() + (depth - 1) * count, count);
+    } else if (IsBinaryOperator(token.type)) {
+      if (depth < 2) return false;
+      double* lhs = stack.data() + (depth - 2) * count;
+      const double* rhs = lhs + count;
+      BinaryCallback callback = GetBinaryCallback(token.type);
+      for (size_t i = 0; i < count; ++i) lhs[i] = callback(lhs[i], rhs[i]);
+      depth--;
+    }
+  }
+  if (depth == 0) return false;
+  const double* top = stack.data() + (depth - 1) * count;
+  std::copy(top, top + count, results);
+  return true;
+}
+
+const Calculation::Stats& Calculation::GetStats() const noexcept {
+  return stats_;
+}
+void Calculation::ResetStats() noexcept { stats_ = Stats{}; }
+bool Calculation::IsStatsEnabled() noexcept { return STATS_ENABLED; }
+
 void Calculation::Reset() {
+  Rewind();
+  prev_ = UNDEF;
+  stack_.clear();
+  tokens_.clear();
+  output_queue_.clear();
+  parsed_expr_.clear();
+  tokenizer_checkpoints_.clear();
+  shunting_checkpoints_.clear();
+}
+
+/* Prepare for parsing, keeping checkpoints of previous parse. */
+void Calculation::Rewind() {
   result_ = NAN;
   status_ = READY;
-  prev_ = UNDEF;
-  while (!stack_.empty()) stack_.pop();
+  resume_ = false;
   while (!calc_stack_.empty()) calc_stack_.pop();
-  output_queue_.clear();
 }
 
 void Calculation::Parse() {
-  TrimSpaces(expr_);
+  Normalize();
   if (expr_.empty()) {
     status_ = EMPTY;
     return;
   }
-  CommaToDot(expr_);
-  iter_ = expr_.begin();
-  while (iter_ != expr_.end()) {
-    if (*iter_ == ' ') {
-      iter_++;
-    } else {
-      CheckHiddenMultiplication();
-    }
-    ParseToken();
-    if (status_ == PARSE_ERROR) return;
-  }
-  while (!stack_.empty()) {
-    if (stack_.top() == RIGHT_PAR || stack_.top() == LEFT_PAR) {
-      status_ = PARSE_ERROR;
-      return;
-    }
-    if (IsBinaryOperator(stack_.top()) || IsUnaryOperator(stack_.top())) {
-      output_queue_.push_back(Token{stack_.top(), NAN});
-      stack_.pop();
-    }
-  }
-  status_ = PARSED;
+  Tokenize();
+  if (status_ == PARSE_ERROR) return;
+  ShuntingYard();
 }
 
 void Calculation::Calculate() {
+  StatsTimer timer(stats_.evaluate_ns, stats_.evaluate_calls);
   double x1 = NAN, x2 = NAN;
   for (Token token : output_queue_) {
     if (token.type == NUM) {
       calc_stack_.push(token.number);
     } else if (token.type == X) {
       calc_stack_.push(x_);
+    } else if (token.type == Y) {
+      calc_stack_.push(y_);
     } else if (IsFunction(token.type) || IsUnaryOperator(token.type)) {
       if (calc_stack_.empty()) {
         status_ = CALCULATE_ERROR;
@@ -118,28 +213,199 @@ void Calculation::Calculate() {
       calc_stack_.pop();
       calc_stack_.push(GetBinaryCallback(token.type)(x1, x2));
     }
+    if constexpr (STATS_ENABLED)
+      stats_.peak_stack_depth =
+          std::max(stats_.peak_stack_depth, calc_stack_.size());
   }
   result_ = calc_stack_.top();
   calc_stack_.pop();
   status_ = COMPLETED;
 }
 
+/* Parsing phases */
+
+/* Bring expression to the form expected by tokenizer. */
+void Calculation::Normalize() {
+  StatsTimer timer(stats_.normalize_ns, stats_.normalize_calls);
+  TrimSpaces(expr_);
+  CommaToDot(expr_);
+}
+
+/* Split expression into tokens, checking that each of them is allowed after
+the previous one. Hidden multiplication is put as explicit MULT token. */
+void Calculation::Tokenize() {
+  StatsTimer timer(stats_.tokenize_ns, stats_.tokenize_calls);
+  iter_ = expr_.begin() + RestoreTokenizer();
+  while (iter_ != expr_.end()) {
+    if (*iter_ == ' ') {
+      iter_++;
+    } else {
+      CheckHiddenMultiplication();
+    }
+    ParseToken();
+    if (status_ == PARSE_ERROR) return;
+    tokenizer_checkpoints_.push_back(TokenizerCheckpoint{
+        static_cast<size_t>(iter_ - expr_.cbegin()), tokens_.size(), prev_});
+  }
+}
+
+/* Convert token list to reverse polish notation in output_queue_. */
+void Calculation::ShuntingYard() {
+  StatsTimer timer(stats_.shunting_yard_ns, stats_.shunting_yard_calls);
+  for (size_t i = RestoreShuntingYard(); i < tokens_.size(); ++i) {
+    const Token& token = tokens_[i];
+    if (token.type == NUM || IsVariable(token.type)) {
+      output_queue_.push_back(token);
+    } else if (IsBinaryOperator(token.type)) {
+      PushOperator(token.type);
+    } else if (token.type == RIGHT_PAR) {
+      PopParenthesis();
+      if (status_ == PARSE_ERROR) return;
+    } else {
+      stack_.push_back(token.type);
+    }
+    bool pushed = token.type != NUM && !IsVariable(token.type) &&
+                  token.type != RIGHT_PAR;
+    shunting_checkpoints_.push_back(ShuntingCheckpoint{
+        output_queue_.size(), stack_.size(), pushed ? token.type : UNDEF});
+  }
+  while (!stack_.empty()) {
+    if (stack_.back() == RIGHT_PAR || stack_.back() == LEFT_PAR) {
+      status_ = PARSE_ERROR;
+      return;
+    }
+    if (IsBinaryOperator(stack_.back()) || IsUnaryOperator(stack_.back())) {
+      output_queue_.push_back(Token{stack_.back(), NAN});
+      stack_.pop_back();
+    }
+  }
+  status_ = PARSED;
+}
+
+/* Find the last token that is not affected by the difference between current
+and previously parsed expressions and restore tokenizer state after it. Token
+can look one symbol beyond its end, so it must end before the first changed
+symbol. Return position to continue from. */
+size_t Calculation::RestoreTokenizer() {
+  size_t same = std::mismatch(expr_.begin(),
+                              expr_.begin() + std::min(expr_.size(),
+                                                       parsed_expr_.size()),
+                              parsed_expr_.begin())
+                    .first -
+                expr_.begin();
+  parsed_expr_ = expr_;
+  while (!tokenizer_checkpoints_.empty() &&
+         tokenizer_checkpoints_.back().position >= same)
+    tokenizer_checkpoints_.pop_back();
+  TokenizerCheckpoint last{};
+  if (!tokenizer_checkpoints_.empty()) last = tokenizer_checkpoints_.back();
+  tokens_.erase(tokens_.begin() + last.tokens, tokens_.end());
+  prev_ = last.prev;
+  if (shunting_checkpoints_.size() > last.tokens)
+    shunting_checkpoints_.erase(
+        shunting_checkpoints_.begin() + last.tokens + 1,
+        shunting_checkpoints_.end());
+  return last.position;
+}
+
+/* Restore output queue and operator stack after the last token processed with
+unchanged tokens before it. Return index of token to continue from. Every token
+only pops operators and then pushes at most one, so the operator on level i of
+restored stack is pushed by the latest token that left the stack not lower
+than i + 1 and never went below that level after it. */
+size_t Calculation::RestoreShuntingYard() {
+  if (shunting_checkpoints_.empty())
+    shunting_checkpoints_.push_back(ShuntingCheckpoint{});
+  const ShuntingCheckpoint& last = shunting_checkpoints_.back();
+  output_queue_.erase(output_queue_.begin() + last.output,
+                      output_queue_.end());
+  stack_.assign(last.depth, UNDEF);
+  size_t low = last.depth;
+  for (size_t i = shunting_checkpoints_.size(); low > 0; --i) {
+    const ShuntingCheckpoint& point = shunting_checkpoints_[i - 1];
+    size_t floor = point.depth - (point.pushed != UNDEF);
+    if (point.pushed != UNDEF && floor < low) stack_[floor] = point.pushed;
+    low = std::min(low, floor);
+  }
+  return shunting_checkpoints_.size() - 1;
+}
+
 /* Misc */
 
 void Calculation::CalculateUnaryOrFunction(TokenType token_type) {
   double x1 = calc_stack_.top();
   calc_stack_.pop();
+  calc_stack_.push(ApplyUnary(token_type, x1));
+}
+
+double Calculation::ApplyUnary(TokenType token_type, double x1) const {
   if (trig_value_ == DEG) {
     if (IsFunction(token_type) &&
         GetFunctionType(token_type) == TRIGONOMICAL_STRAIGHT)
-      calc_stack_.push(GetUnaryCallback(token_type)(x1 * M_PI / 180.0));
+      return GetUnaryCallback(token_type)(x1 * M_PI / 180.0);
     else if (IsFunction(token_type) &&
              GetFunctionType(token_type) == TRIGONOMICAL_ARC)
-      calc_stack_.push(GetUnaryCallback(token_type)(x1) * 180.0 / M_PI);
-    else
-      calc_stack_.push(GetUnaryCallback(token_type)(x1));
-  } else
-    calc_stack_.push(GetUnaryCallback(token_type)(x1));
+      return GetUnaryCallback(token_type)(x1) * 180.0 / M_PI;
+  }
+  return GetUnaryCallback(token_type)(x1);
+}
+
+/* Callback and angle conversion are resolved once for the whole block. */
+void Calculation::ApplyUnary(TokenType token_type, double* values,
+                             size_t count) const {
+  UnaryCallback callback = GetUnaryCallback(token_type);
+  FuncType type = REGULAR;
+  if (trig_value_ == DEG && IsFunction(token_type))
+    type = GetFunctionType(token_type);
+  if (type == TRIGONOMICAL_STRAIGHT) {
+    for (size_t i = 0; i < count; ++i)
+      values[i] = callback(values[i] * M_PI / 180.0);
+  } else if (type == TRIGONOMICAL_ARC) {
+    for (size_t i = 0; i < count; ++i)
+      values[i] = callback(values[i]) * 180.0 / M_PI;
+  } else {
+    for (size_t i = 0; i < count; ++i) values[i] = callback(values[i]);
+  }
+}
+
+void Calculation::PushToken(TokenType type, double number) {
+  tokens_.push_back(Token{type, number});
+  prev_ = type;
+  if constexpr (STATS_ENABLED) ++stats_.tokens;
+}
+
+void Calculation::PushOperator(TokenType token) {
+  while (!stack_.empty() &&
+         ((IsBinaryOperator(stack_.back()) &&
+           (GetPriority(stack_.back()) > GetPriority(token) ||
+            (GetPriority(stack_.back()) == GetPriority(token) &&
+             token != POW))) ||
+          IsUnaryOperator(stack_.back()))) {
+    output_queue_.push_back(Token{stack_.back(), NAN});
+    stack_.pop_back();
+  }
+  stack_.push_back(token);
+}
+
+void Calculation::PopParenthesis() {
+  while (!stack_.empty() && stack_.back() != LEFT_PAR &&
+         (IsBinaryOperator(stack_.back()) || IsUnaryOperator(stack_.back()))) {
+    output_queue_.push_back(Token{stack_.back(), NAN});
+    stack_.pop_back();
+  }
+  if (stack_.empty())
+    status_ = PARSE_ERROR;
+  else if (stack_.back() == LEFT_PAR) {
+    stack_.pop_back();
+    if (!stack_.empty() && IsFunction(stack_.back())) {
+      output_queue_.push_back(Token{stack_.back(), NAN});
+      stack_.pop_back();
+    }
+    while (!stack_.empty() && IsUnaryOperator(stack_.back())) {
+      output_queue_.push_back(Token{stack_.back(), NAN});
+      stack_.pop_back();
+    }
+  }
 }
 
 void Calculation::ParseToken() {
@@ -147,6 +413,7 @@ void Calculation::ParseToken() {
   std::string::const_iterator init = iter_;
   parsed = CheckNumber(init);
   if (!parsed) parsed = CheckX(init);
+  if (!parsed) parsed = CheckY(init);
   if (!parsed) parsed = CheckFunction(init);
   if (!parsed) parsed = CheckLeftParenthesis(init);
   if (!parsed) parsed = CheckUnarOperator(init);
@@ -157,18 +424,12 @@ void Calculation::ParseToken() {
 
 void Calculation::CheckHiddenMultiplication() {
   if ((prev_ == NUM &&
-       (ParseFunction(iter_) != UNDEF || *iter_ == '(' || *iter_ == 'x')) ||
-      (prev_ == X && *iter_ == '(') || (prev_ == RIGHT_PAR && *iter_ == '(') ||
+       (ParseFunction(iter_) != UNDEF || *iter_ == '(' || *iter_ == 'x' ||
+        *iter_ == 'y')) ||
+      (IsVariable(prev_) && *iter_ == '(') ||
+      (prev_ == RIGHT_PAR && *iter_ == '(') ||
       (prev_ == RIGHT_PAR && IsFunction(ParseFunction(iter_)))) {
-    while (!stack_.empty() &&
-           ((IsBinaryOperator(stack_.top()) &&
-             GetPriority(stack_.top()) >= GetPriority(MULT)) ||
-            IsUnaryOperator(stack_.top()))) {
-      output_queue_.push_back(Token{stack_.top(), NAN});
-      stack_.pop();
-    }
-    stack_.push(MULT);
-    prev_ = MULT;
+    PushToken(MULT);
   }
 }
 
@@ -177,9 +438,9 @@ bool Calculation::CheckNumber(std::string::const_iterator input) {
     int shift = 0;
     double number = 0.0;
     sscanf(&input[0], "%lf%n", &number, &shift);
-    if (shift > 0 && prev_ != X && prev_ != NUM && prev_ != RIGHT_PAR) {
-      output_queue_.push_back(Token{NUM, number});
-      prev_ = NUM;
+    if (shift > 0 && !IsVariable(prev_) && prev_ != NUM &&
+        prev_ != RIGHT_PAR) {
+      PushToken(NUM, number);
       iter_ += shift;
       return true;
     }
@@ -188,9 +449,17 @@ bool Calculation::CheckNumber(std::string::const_iterator input) {
 }
 
 bool Calculation::CheckX(std::string::const_iterator input) {
-  if (*input == 'x' && prev_ != X && prev_ != RIGHT_PAR) {
-    output_queue_.push_back(Token{X, NAN});
-    prev_ = X;
+  if (*input == 'x' && !IsVariable(prev_) && prev_ != RIGHT_PAR) {
+    PushToken(X);
+    iter_++;
+    return true;
+  }
+  return false;
+}
+
+bool Calculation::CheckY(std::string::const_iterator input) {
+  if (*input == 'y' && !IsVariable(prev_) && prev_ != RIGHT_PAR) {
+    PushToken(Y);
     iter_++;
     return true;
   }
@@ -200,9 +469,9 @@ bool Calculation::CheckX(std::string::const_iterator input) {
 bool Calculation::CheckFunction(std::string::const_iterator input) {
   TokenType value = UNDEF;
   value = ParseFunction(input);
-  if (value != UNDEF && prev_ != RIGHT_PAR && prev_ != X && prev_ != NUM) {
-    stack_.push(value);
-    prev_ = value;
+  if (value != UNDEF && prev_ != RIGHT_PAR && !IsVariable(prev_) &&
+      prev_ != NUM) {
+    PushToken(value);
     iter_ += GetString(value).size();
     return true;
   }
@@ -223,8 +492,7 @@ Calculation::TokenType Calculation::ParseFunction(
 
 bool Calculation::CheckLeftParenthesis(std::string::const_iterator input) {
   if (*input == '(') {
-    stack_.push(LEFT_PAR);
-    prev_ = LEFT_PAR;
+    PushToken(LEFT_PAR);
     iter_++;
     return true;
   }
@@ -232,12 +500,11 @@ bool Calculation::CheckLeftParenthesis(std::string::const_iterator input) {
 }
 
 bool Calculation::CheckUnarOperator(std::string::const_iterator input) {
-  if (prev_ != NUM && prev_ != X && prev_ != RIGHT_PAR) {
+  if (prev_ != NUM && !IsVariable(prev_) && prev_ != RIGHT_PAR) {
     for (const auto& [key, value] : unary_operators) {
       if (!strncmp(&input[0], GetString(key).data(), GetString(key).size()) &&
           *(input + GetString(key).size()) != ' ') {
-        stack_.push(key);
-        prev_ = key;
+        PushToken(key);
         iter_ += GetString(key).size();
         return true;
       }
@@ -249,17 +516,7 @@ bool Calculation::CheckUnarOperator(std::string::const_iterator input) {
 bool Calculation::CheckOperator(std::string::const_iterator input) {
   for (const auto& [key, value] : operators) {
     if (!strncmp(&input[0], GetString(key).data(), GetString(key).size())) {
-      while (
-          !stack_.empty() &&
-          ((IsBinaryOperator(stack_.top()) &&
-            (GetPriority(stack_.top()) > GetPriority(key) ||
-             (GetPriority(stack_.top()) == GetPriority(key) && key != POW))) ||
-           IsUnaryOperator(stack_.top()))) {
-        output_queue_.push_back(Token{stack_.top(), NAN});
-        stack_.pop();
-      }
-      stack_.push(key);
-      prev_ = key;
+      PushToken(key);
       iter_ += GetString(key).size();
       return true;
     }
@@ -269,25 +526,7 @@ bool Calculation::CheckOperator(std::string::const_iterator input) {
 
 bool Calculation::CheckRightParenthesis(std::string::const_iterator input) {
   if (*input == ')') {
-    while (!stack_.empty() && stack_.top() != LEFT_PAR &&
-           (IsBinaryOperator(stack_.top()) || IsUnaryOperator(stack_.top()))) {
-      output_queue_.push_back(Token{stack_.top(), NAN});
-      stack_.pop();
-    }
-    if (stack_.empty())
-      status_ = PARSE_ERROR;
-    else if (stack_.top() == LEFT_PAR) {
-      stack_.pop();
-      if (!stack_.empty() && IsFunction(stack_.top())) {
-        output_queue_.push_back(Token{stack_.top(), NAN});
-        stack_.pop();
-      }
-      while (!stack_.empty() && IsUnaryOperator(stack_.top())) {
-        output_queue_.push_back(Token{stack_.top(), NAN});
-        stack_.pop();
-      }
-    }
-    prev_ = RIGHT_PAR;
+    PushToken(RIGHT_PAR);
     iter_++;
     return true;
   }
@@ -304,16 +543,18 @@ const std::string Calculation::GetString(TokenType value) {
   return std::get<0>(functions.at(value));
 }
 
-Calculation::UnaryCallback Calculation::GetUnaryCallback(TokenType value) {
+Calculation::UnaryCallback Calculation::GetUnaryCallback(
+    TokenType value) const {
   if (IsUnaryOperator(value)) return std::get<1>(unary_operators.at(value));
   return std::get<1>(functions.at(value));
 }
 
-Calculation::BinaryCallback Calculation::GetBinaryCallback(TokenType value) {
+Calculation::BinaryCallback Calculation::GetBinaryCallback(
+    TokenType value) const {
   return std::get<1>(operators.at(value));
 }
 
-Calculation::FuncType Calculation::GetFunctionType(TokenType value) {
+Calculation::FuncType Calculation::GetFunctionType(TokenType value) const {
   return std::get<2>(functions.at(value));
 }
 
@@ -325,6 +566,10 @@ bool Calculation::IsUnaryOperator(TokenType value) noexcept {
   return value >= PLUS && value <= MINUS_ALT;
 }
 
+bool Calculation::IsVariable(TokenType value) noexcept {
+  return value == X || value == Y;
+}
+
 bool Calculation::IsFunction(TokenType value) noexcept {
   return value >= SQRT && value <= ATAN;
 }
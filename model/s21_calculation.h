@@ -31,10 +31,30 @@ class Calculation {
 
   enum TrigType { RAD, DEG };
 
+  /* Cumulative counters of parsing and evaluation phases. They are collected
+   * only when the library is built with S21_CALCULATION_STATS defined,
+   * otherwise all the fields stay zero. */
+  struct Stats {
+    unsigned long long normalize_ns = 0;
+    unsigned long long normalize_calls = 0;
+    unsigned long long tokenize_ns = 0;
+    unsigned long long tokenize_calls = 0;
+    unsigned long long shunting_yard_ns = 0;
+    unsigned long long shunting_yard_calls = 0;
+    unsigned long long evaluate_ns = 0;
+    unsigned long long evaluate_calls = 0;
+    unsigned long long tokens = 0;
+    size_t peak_stack_depth = 0;
+  };
+
   /* Set methods */
   void SetX(double x) noexcept;
   void SetX(const std::string& x_str) noexcept;
+  void SetY(double y) noexcept;
   void SetExpression(const std::string& input) noexcept;
+  /* Same as SetExpression, but next parse reuses tokens and operator stack
+   * states of the part that is equal to previously parsed expression. */
+  void UpdateExpression(const std::string& input) noexcept;
   void SetRadian() noexcept;
   void SetDegree() noexcept;
 
@@ -43,12 +63,29 @@ class Calculation {
   Status GetStatus() const noexcept;
   const std::string GetExpression() const noexcept;
   double GetX() const noexcept;
+  double GetY() const noexcept;
   double GetResult();
   double GetResult(double x);
   double GetResult(const std::string& input);
   double GetResult(const std::string& input, double x);
   double GetResult(const std::string& input, const std::string& x);
 
+  /* Block evaluation. Compile parses expression if it is not parsed yet and
+   * returns true if it can be evaluated. GetResults evaluates parsed
+   * expression for 'count' values of x, processing the whole block on every
+   * token. It does not change the object, so it may be called from several
+   * threads at once. Returns false if expression is not compiled or invalid.
+   * Variable y is NaN unless its values are given. */
+  bool Compile();
+  bool GetResults(const double* x, double* results, size_t count) const;
+  bool GetResults(const double* x, const double* y, double* results,
+                  size_t count) const;
+
+  /* Stats methods */
+  const Stats& GetStats() const noexcept;
+  void ResetStats() noexcept;
+  static bool IsStatsEnabled() noexcept;
+
  private:
   enum TokenType {
     /* Unary functions */
@@ -77,7 +114,8 @@ class Calculation {
     NUM,
     LEFT_PAR,
     RIGHT_PAR,
-    X
+    X,
+    Y
   };
 
   enum FuncType { REGULAR, TRIGONOMICAL_ARC, TRIGONOMICAL_STRAIGHT };
@@ -89,36 +127,75 @@ class Calculation {
     double number = NAN;
   };
 
+  /* Tokenizer state after a token that ends at 'position' of expression. */
+  struct TokenizerCheckpoint {
+    size_t position = 0;
+    size_t tokens = 0;
+    TokenType prev = UNDEF;
+  };
+
+  /* Shunting-yard state after processing of corresponding token: sizes of
+   * output queue and operator stack and the operator pushed by the token,
+   * UNDEF if it pushed nothing. */
+  struct ShuntingCheckpoint {
+    size_t output = 0;
+    size_t depth = 0;
+    TokenType pushed = UNDEF;
+  };
+
   /* Main variables */
   Status status_ = READY;
   std::string expr_{};
   double x_ = NAN;
+  double y_ = NAN;
   double result_ = NAN;
   TrigType trig_value_ = RAD;
+  Stats stats_{};
 
   /* Parsing variables */
   std::string::const_iterator iter_;
-  std::stack<TokenType> stack_{};
+  std::vector<Token> tokens_{};
+  std::vector<TokenType> stack_{};
   TokenType prev_ = UNDEF;
 
+  /* Incremental parsing variables */
+  bool resume_ = false;
+  std::string parsed_expr_{};
+  std::vector<TokenizerCheckpoint> tokenizer_checkpoints_{};
+  std::vector<ShuntingCheckpoint> shunting_checkpoints_{};
+
   /* Calculation variables */
   std::vector<Token> output_queue_{};
   std::stack<double> calc_stack_{};
 
   void Reset();
+  void Rewind();
   void Parse();
   void Calculate();
 
+  /* Parsing phases */
+  void Normalize();
+  void Tokenize();
+  void ShuntingYard();
+  size_t RestoreTokenizer();
+  size_t RestoreShuntingYard();
+
   /* Misc */
   void TrimSpaces(std::string& str);
   void CommaToDot(std::string& str);
 
   void CalculateUnaryOrFunction(TokenType token);
+  double ApplyUnary(TokenType token, double x) const;
+  void ApplyUnary(TokenType token, double* values, size_t count) const;
 
+  void PushToken(TokenType type, double number = NAN);
+  void PushOperator(TokenType token);
+  void PopParenthesis();
   void ParseToken();
   void CheckHiddenMultiplication();
   bool CheckNumber(std::string::const_iterator input);
   bool CheckX(std::string::const_iterator input);
+  bool CheckY(std::string::const_iterator input);
   bool CheckFunction(std::string::const_iterator input);
   TokenType ParseFunction(std::string::const_iterator input);
   bool CheckLeftParenthesis(std::string::const_iterator input);
@@ -128,10 +205,11 @@ class Calculation {
 
   int GetPriority(TokenType value);
   const std::string GetString(TokenType value);
-  UnaryCallback GetUnaryCallback(TokenType value);
-  BinaryCallback GetBinaryCallback(TokenType value);
-  FuncType GetFunctionType(TokenType value);
+  UnaryCallback GetUnaryCallback(TokenType value) const;
+  BinaryCallback GetBinaryCallback(TokenType value) const;
+  FuncType GetFunctionType(TokenType value) const;
 
+  static bool IsVariable(TokenType value) noexcept;
   static bool IsFunction(TokenType value) noexcept;
   static bool IsBinaryOperator(TokenType value) noexcept;
   static bool IsUnaryOperator(TokenType value) noexcept;
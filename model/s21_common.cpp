@@ -56,205 +56,215 @@ long double bankRoundLongTwoDecimal(long double number) noexcept {
   return bankRoundLong(number * 100.0L) / 100.0L;
 }
 
+/* Today in local time. localtime_r fills caller's storage, so dates may be
+ * created on several threads; the rest of Date does not touch time zone. */
 Date::Date() {
   time_t t = std::time(NULL);
-  if (std::localtime(&t) == NULL)
+  struct std::tm current;
+  if (localtime_r(&t, &current) == NULL)
     throw std::runtime_error(
         "Can't read local time format or it doesn't exist.");
-  current_ = *std::localtime(&t);
-  current_.tm_sec = 0;
-  current_.tm_min = 0;
-  current_.tm_hour = 12;
-  base_.tm_sec = 0;
-  base_.tm_min = 0;
-  base_.tm_hour = 12;
-  base_.tm_mday = BASE_DAY;
-  base_.tm_mon = BASE_MONTH - 1;
-  base_.tm_year = BASE_YEAR - 1900;
+  serial_ = daysFromCivil(current.tm_mday, current.tm_mon + 1,
+                          current.tm_year + 1900);
 }
 
-Date::Date(int day, int month, int year) {
-  if (isDateValid(day, month, year) == false)
-    throw std::invalid_argument("Invalid date.");
-  current_.tm_sec = 0;
-  current_.tm_min = 0;
-  current_.tm_hour = 12;
-  current_.tm_mday = day;
-  current_.tm_mon = month - 1;
-  current_.tm_year = year - 1900;
-  base_.tm_sec = 0;
-  base_.tm_min = 0;
-  base_.tm_hour = 12;
-  base_.tm_mday = BASE_DAY;
-  base_.tm_mon = BASE_MONTH - 1;
-  base_.tm_year = BASE_YEAR - 1900;
-}
-
-void Date::setDate(int day, int month, int year) {
-  if (isDateValid(day, month, year) == false)
-    throw std::invalid_argument("Invalid date.");
-  current_.tm_mday = day;
-  current_.tm_mon = month - 1;
-  current_.tm_year = year - 1900;
-}
-
-int Date::getDay() const noexcept { return current_.tm_mday; }
-
-int Date::getMonth() const noexcept { return current_.tm_mon + 1; }
-
-int Date::getYear() const noexcept { return current_.tm_year + 1900; }
-
-int Date::subtract(const Date& sub) const {
-  return getDiff(current_, sub.current_);
-}
-
-int Date::operator|(const Date& sub) const { return subtract(sub); }
-
-Date operator+(int days, const Date& date) {
-  Date date_new(date);
-  date_new.addDays(days);
-  return date_new;
-}
-
-Date Date::operator+(int days) const {
-  Date date_new(*this);
-  date_new.addDays(days);
-  return date_new;
-}
-
-Date Date::operator-(int days) const {
-  Date date_new(*this);
-  date_new.addDays(-days);
-  return date_new;
-}
-
-Date Date::operator+=(int days) {
-  addDays(days);
-  return *this;
-}
-
-Date Date::operator-=(int days) {
-  addDays(-days);
-  return *this;
+/* Shifted day number is not negative from 1.3.0000, so eras are counted by
+ * unsigned division and month selection is a plain select. */
+void Date::toCivil(const int* __restrict serials, int* __restrict days,
+                   int* __restrict months, int* __restrict years,
+                   size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    const unsigned shifted =
+        static_cast<unsigned>(serials[i] + BASE_OFFSET + 719468);
+    const unsigned era = shifted / 146097;
+    const unsigned day_of_era = shifted - era * 146097;
+    const unsigned year_of_era = (day_of_era - day_of_era / 1460 +
+                                  day_of_era / 36524 - day_of_era / 146096) /
+                                 365;
+    const unsigned day_of_year =
+        day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const unsigned month_from_march = (5 * day_of_year + 2) / 153;
+    const unsigned month =
+        month_from_march < 10 ? month_from_march + 3 : month_from_march - 9;
+    days[i] = static_cast<int>(day_of_year -
+                               (153 * month_from_march + 2) / 5 + 1);
+    months[i] = static_cast<int>(month);
+    years[i] = static_cast<int>(year_of_era + era * 400 + (month <= 2));
+  }
 }
 
-Date Date::operator++(int) {
-  addDays(1);
-  return *this;
+void Date::fromCivil(const int* __restrict days,
+                     const int* __restrict months,
+                     const int* __restrict years, int* __restrict serials,
+                     size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    const unsigned month = static_cast<unsigned>(months[i]);
+    const unsigned year = static_cast<unsigned>(years[i]) - (month <= 2);
+    const unsigned era = year / 400;
+    const unsigned year_of_era = year - era * 400;
+    const unsigned day_of_year =
+        (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+        static_cast<unsigned>(days[i]) - 1;
+    const unsigned day_of_era =
+        year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    serials[i] = static_cast<int>(era * 146097 + day_of_era) - 719468 -
+                 BASE_OFFSET;
+  }
 }
 
-Date Date::operator--(int) {
-  addDays(-1);
-  return *this;
+void Date::toMonthBuckets(const int* __restrict serials,
+                          int* __restrict buckets, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    const unsigned shifted =
+        static_cast<unsigned>(serials[i] + BASE_OFFSET + 719468);
+    const unsigned era = shifted / 146097;
+    const unsigned day_of_era = shifted - era * 146097;
+    const unsigned year_of_era = (day_of_era - day_of_era / 1460 +
+                                  day_of_era / 36524 - day_of_era / 146096) /
+                                 365;
+    const unsigned day_of_year =
+        day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    /* Months are counted from March of year_of_era, bucket 2 is March. */
+    const unsigned month_from_march = (5 * day_of_year + 2) / 153;
+    buckets[i] =
+        static_cast<int>((year_of_era + era * 400) * 12 + month_from_march + 2);
+  }
 }
 
-Date Date::operator++() {
-  addDays(1);
-  return *this;
-}
+Calendar::Calendar(int first_year, int last_year)
+    : first_year_(std::max(first_year, FIRST_YEAR)), last_year_(last_year) {}
 
-Date Date::operator--() {
-  addDays(-1);
-  return *this;
+bool Calendar::setWeekend(unsigned mask) {
+  mask &= 0xFEu;
+  if (mask == 0xFEu) return false;
+  weekend_ = mask;
+  if (years_.empty() == false) build();
+  return true;
 }
 
-bool Date::operator==(const Date& date) const {
-  return getDaysSinceBase() == date.getDaysSinceBase();
+void Calendar::addHoliday(Date date) {
+  holidays_.push_back(date);
+  if (years_.empty())
+    build();
+  else
+    mark(date);
 }
 
-bool Date::operator!=(const Date& date) const {
-  return getDaysSinceBase() != date.getDaysSinceBase();
+bool Calendar::addAnnualHoliday(int day, int month, Observance observance) {
+  /* Leap year accepts every day that may exist. */
+  if (Date::isDateValid(day, month, 2000) == false) return false;
+  Annual annual{day, month, observance};
+  annual_.push_back(annual);
+  if (years_.empty()) {
+    build();
+  } else {
+    for (int year = first_year_; year <= last_year_; ++year) {
+      if (Date::isDateValid(day, month, year) == false) continue;
+      mark(Date(day, month, year));
+      mark(observed(annual, year));
+    }
+  }
+  return true;
 }
 
-bool Date::operator>=(const Date& date) const {
-  return getDaysSinceBase() >= date.getDaysSinceBase();
+void Calendar::clearHolidays() {
+  holidays_.clear();
+  annual_.clear();
+  years_.clear();
 }
 
-bool Date::operator<=(const Date& date) const {
-  return getDaysSinceBase() <= date.getDaysSinceBase();
-}
+unsigned Calendar::getWeekend() const noexcept { return weekend_; }
 
-bool Date::operator>(const Date& date) const {
-  return getDaysSinceBase() > date.getDaysSinceBase();
+bool Calendar::isWeekend(Date date) const noexcept {
+  return (weekend_ >> date.getWeekday()) & 1u;
 }
 
-bool Date::operator<(const Date& date) const {
-  return getDaysSinceBase() < date.getDaysSinceBase();
+bool Calendar::isBusinessDay(Date date) const {
+  int year = date.getYear();
+  if (years_.empty() == false && year >= first_year_ && year <= last_year_)
+    return years_[year - first_year_].test(date | Date(1, 1, year)) == false;
+  return isClosedByRules(date) == false;
 }
 
-void Date::addDays(int days) {
-  std::tm new_date = current_;
-  time_t tmp = std::mktime(&new_date);
-  tmp += static_cast<time_t>(days) * (60 * 60 * 24);
-  new_date = *std::localtime(&tmp);
-  current_ = new_date;
+Date Calendar::adjust(Date date, Adjustment adjustment) const {
+  switch (adjustment) {
+    case A_FOLLOWING:
+      return roll(date, 1);
+    case A_PRECEDING:
+      return roll(date, -1);
+    case A_MODIFIED_FOLLOWING: {
+      /* Following day unless it is in the next month. */
+      Date next = roll(date, 1);
+      if (next.getMonth() == date.getMonth() &&
+          next.getYear() == date.getYear())
+        return next;
+      return roll(date, -1);
+    }
+
+    default:
+      return date;
+  }
 }
 
-void Date::addMonths(int months) {
-  int new_day = getDay(), new_month = 0, new_year = 0;
-  if (getMonth() + months <= 0) {
-    new_month = 12 - std::abs(getMonth() + months) % 12;
-    new_year = getYear() - 1 - std::abs(getMonth() + months) / 12;
-  } else {
-    new_month = (getMonth() + months - 1) % 12 + 1;
-    new_year = getYear() + (getMonth() + months - 1) / 12;
+/* Weekends are marked by walking days of each year, then all holidays. */
+void Calendar::build() {
+  years_.assign(last_year_ >= first_year_ ? last_year_ - first_year_ + 1 : 0,
+                std::bitset<366>());
+  for (size_t i = 0; i < years_.size(); ++i) {
+    int year = first_year_ + static_cast<int>(i);
+    Date day(1, 1, year);
+    int length = (Date(31, 12, year) | day) + 1;
+    for (int j = 0; j < length; ++j, ++day)
+      if (isWeekend(day)) years_[i].set(j);
   }
-
-  while (!isDateValid(new_day, new_month, new_year)) {
-    new_day--;
+  for (const Date& date : holidays_) mark(date);
+  for (const Annual& annual : annual_) {
+    for (int year = first_year_; year <= last_year_; ++year) {
+      if (Date::isDateValid(annual.day, annual.month, year) == false) continue;
+      mark(Date(annual.day, annual.month, year));
+      mark(observed(annual, year));
+    }
   }
-  setDate(new_day, new_month, new_year);
 }
 
-void Date::addYears(int years) {
-  int new_year = getYear() + years;
-  if (!isDateValid(getDay(), getMonth(), new_year))
-    setDate(getDay() - 1, getMonth(), new_year);
-  else
-    setDate(getDay(), getMonth(), new_year);
+void Calendar::mark(Date date) {
+  int year = date.getYear();
+  if (year >= first_year_ && year <= last_year_)
+    years_[year - first_year_].set(date | Date(1, 1, year));
 }
 
-Date Date::shiftMonths(int months) const {
-  Date ret = *this;
-  ret.addMonths(months);
-  return ret;
+/* Observed day may move holiday to the neighbour year. */
+bool Calendar::isClosedByRules(Date date) const {
+  if (isWeekend(date)) return true;
+  if (std::find(holidays_.begin(), holidays_.end(), date) != holidays_.end())
+    return true;
+  int year = date.getYear();
+  for (const Annual& annual : annual_) {
+    for (int y = year - 1; y <= year + 1; ++y) {
+      if (Date::isDateValid(annual.day, annual.month, y) &&
+          (Date(annual.day, annual.month, y) == date ||
+           observed(annual, y) == date))
+        return true;
+    }
+  }
+  return false;
 }
 
-int Date::getDaysSinceBase() const { return getDiff(current_, base_); }
-
-int Date::getDiff(const struct std::tm& end,
-                  const struct std::tm& start) const {
-  struct std::tm end_new = {}, start_new = {};
-  end_new.tm_sec = end.tm_sec;
-  end_new.tm_min = end.tm_min;
-  end_new.tm_hour = end.tm_hour;
-  end_new.tm_mday = end.tm_mday;
-  end_new.tm_mon = end.tm_mon;
-  end_new.tm_year = end.tm_year;
-  start_new.tm_sec = start.tm_sec;
-  start_new.tm_min = start.tm_min;
-  start_new.tm_hour = start.tm_hour;
-  start_new.tm_mday = start.tm_mday;
-  start_new.tm_mon = start.tm_mon;
-  start_new.tm_year = start.tm_year;
-  double difference =
-      std::round(std::difftime(std::mktime(&end_new), std::mktime(&start_new)) /
-                 (60.0 * 60.0 * 24.0));
-  return static_cast<int>(difference);
+Date Calendar::observed(const Annual& annual, int year) const {
+  Date date(annual.day, annual.month, year);
+  if (annual.observance == OB_NONE || isWeekend(date) == false) return date;
+  if (annual.observance == OB_NEAREST_WEEKDAY && isWeekend(date - 1) == false)
+    return date - 1;
+  Date next = date + 1;
+  while (isWeekend(next)) ++next;
+  return next;
 }
 
-bool Date::isDateValid(int d, int m, int y) noexcept {
-  if (y < BASE_YEAR) return false;
-  if (m < 1 || m > 12) return false;
-  if (d < 1 || d > 31) return false;
-  if (d == 31 && (m == 2 || m == 4 || m == 6 || m == 9 || m == 11))
-    return false;
-  if (d == 30 && m == 2) return false;
-  if (m == 2 && d == 29 && y % 4 != 0) return false;
-  if (m == 2 && d == 29 && y % 400 == 0) return true;
-  if (m == 2 && d == 29 && y % 100 == 0) return false;
-  if (m == 2 && d == 29 && y % 4 == 0) return true;
-  return true;
+Date Calendar::roll(Date date, int direction) const {
+  Date day = date;
+  for (int i = 0; i <= MAX_SHIFT; ++i, day += direction)
+    if (isBusinessDay(day)) return day;
+  return date;
 }
 
 }  // namespace s21
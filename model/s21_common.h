@@ -3,9 +3,16 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <bitset>
 #include <cmath>
+#include <cstddef>
 #include <ctime>
+#include <iterator>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace s21 {
 
@@ -14,54 +21,529 @@ double bankRoundTwoDecimal(double number) noexcept;
 long double bankRoundLong(long double number) noexcept;
 long double bankRoundLongTwoDecimal(long double number) noexcept;
 
-/* Class for operating with days in date format. */
+/* Class for operating with days in date format. Date is stored as serial
+ * number of day since BASE date and converted to and from day, month and year
+ * by integer arithmetic of proleptic Gregorian calendar, so comparisons and
+ * arithmetic do not depend on C time library, time zone or DST. */
 class Date {
  public:
+  /* DMY is "dd.mm.yyyy", ISO is "yyyy-mm-dd". */
+  enum Style { DMY, ISO };
+  /* Buffer size for format(), enough for any year and terminating zero. */
+  static constexpr int FORMAT_SIZE = 17;
+
   explicit Date();
-  explicit Date(int day, int month, int year);
+  explicit constexpr Date(int day, int month, int year)
+      : serial_(isDateValid(day, month, year)
+                    ? daysFromCivil(day, month, year)
+                    : throw std::invalid_argument("Invalid date.")) {}
   ~Date() = default;
 
   /* Throw exception if date doesn't exist or 'year' argument is lower than
    * BASE_YEAR. */
-  void setDate(int day, int month, int year);
-
-  int getDay() const noexcept;
-  int getMonth() const noexcept;
-  int getYear() const noexcept;
-  int subtract(const Date& sub) const;
-  int operator|(const Date& sub) const;
-  friend Date operator+(int days, const Date& date);
-  Date operator+(int days) const;
-  Date operator-(int days) const;
-  Date operator+=(int days);
-  Date operator-=(int days);
-  Date operator++(int);
-  Date operator--(int);
-  Date operator++();
-  Date operator--();
-  void addDays(int days);
-  void addMonths(int months);
-  void addYears(int years);
-  Date shiftMonths(int months) const;
-
-  bool operator==(const Date& date) const;
-  bool operator!=(const Date& date) const;
-  bool operator>=(const Date& date) const;
-  bool operator<=(const Date& date) const;
-  bool operator>(const Date& date) const;
-  bool operator<(const Date& date) const;
-
-  static bool isDateValid(int d, int m, int y) noexcept;
+  constexpr void setDate(int day, int month, int year);
+
+  constexpr int getDay() const noexcept;
+  constexpr int getMonth() const noexcept;
+  constexpr int getYear() const noexcept;
+  /* 1 is Monday, 7 is Sunday. */
+  constexpr int getWeekday() const noexcept;
+  /* Days since 1.1.1900, the value stored in Date. */
+  constexpr int getSerial() const noexcept;
+  static constexpr Date fromSerial(int serial) noexcept;
+  constexpr int subtract(const Date& sub) const noexcept;
+  constexpr int operator|(const Date& sub) const noexcept;
+  friend constexpr Date operator+(int days, const Date& date) noexcept;
+  constexpr Date operator+(int days) const noexcept;
+  constexpr Date operator-(int days) const noexcept;
+  constexpr Date operator+=(int days) noexcept;
+  constexpr Date operator-=(int days) noexcept;
+  constexpr Date operator++(int) noexcept;
+  constexpr Date operator--(int) noexcept;
+  constexpr Date operator++() noexcept;
+  constexpr Date operator--() noexcept;
+  constexpr void addDays(int days) noexcept;
+  constexpr void addMonths(int months);
+  constexpr void addYears(int years);
+  constexpr Date shiftMonths(int months) const;
+  constexpr Date shiftMonthsOvercap(int months) const;
+
+  constexpr bool operator==(const Date& date) const noexcept;
+  constexpr bool operator!=(const Date& date) const noexcept;
+  constexpr bool operator>=(const Date& date) const noexcept;
+  constexpr bool operator<=(const Date& date) const noexcept;
+  constexpr bool operator>(const Date& date) const noexcept;
+  constexpr bool operator<(const Date& date) const noexcept;
+
+  static constexpr bool isDateValid(int d, int m, int y) noexcept;
+  static constexpr int daysInMonth(int m, int y) noexcept;
+
+  /* Batch conversion of 'count' serial days to and from day, month and
+   * year arrays by the same algorithm as one date, written without branches
+   * and with unsigned division by constants. Arrays must not overlap, so
+   * loops are vectorized without alias checks at -O3, which model library
+   * is built with. Serials are from 1.3.0000 on (MIN_BATCH_SERIAL), dates
+   * given to fromCivil must exist. */
+  static constexpr int MIN_BATCH_SERIAL = -693901;
+  static void toCivil(const int* __restrict serials, int* __restrict days,
+                      int* __restrict months, int* __restrict years,
+                      size_t count) noexcept;
+  static void fromCivil(const int* __restrict days,
+                        const int* __restrict months,
+                        const int* __restrict years, int* __restrict serials,
+                        size_t count) noexcept;
+  /* Month bucket is year * 12 + month - 1, so buckets of following months
+   * are following numbers. */
+  static void toMonthBuckets(const int* __restrict serials,
+                             int* __restrict buckets, size_t count) noexcept;
+  static constexpr int monthBucket(int month, int year) noexcept;
+
+  /* Text must be exactly "dd.mm.yyyy" or "yyyy-mm-dd" with leading zeros.
+   * Returns false and leaves date as is if it is not or date does not
+   * exist. */
+  static constexpr bool parse(std::string_view text, Date& date) noexcept;
+  /* Writes date and terminating zero, returns pointer to the zero. */
+  constexpr char* format(char* buffer, Style style = DMY) const noexcept;
 
  private:
   static const int BASE_YEAR = 1900;
   static const int BASE_MONTH = 1;
   static const int BASE_DAY = 1;
-  struct std::tm base_ = {};
-  struct std::tm current_ = {};
+  /* Days from 1.1.1970 to BASE date. */
+  static const int BASE_OFFSET = -25567;
+  /* Days since BASE date. */
+  int serial_ = 0;
+
+  struct Civil {
+    int day;
+    int month;
+    int year;
+  };
+
+  static constexpr int daysFromCivil(int day, int month, int year) noexcept;
+  static constexpr Civil civilFromDays(int serial) noexcept;
+  /* Value of 'count' decimal digits from 'first', -1 if any is not digit. */
+  static constexpr int readDigits(std::string_view text, size_t first,
+                                  size_t count) noexcept;
+  static constexpr char* writeDigits(char* buffer, int value,
+                                     int count) noexcept;
+};
+
+static_assert(sizeof(Date) == 4, "Date must be a 32-bit serial day");
+static_assert(std::is_trivially_copyable<Date>::value,
+              "Date must be trivially copyable");
+
+/* Lazy range of recurring dates from 'anchor' with 'step' (positive) days or
+ * months, limited to dates from 'first' to 'last' inclusive. Dates go in
+ * ascending order and are generated one by one on iteration.
+ * R_DAYS: anchor + k * step days.
+ * R_MONTHS: anchor shifted by k * step months, day is clipped to the end of
+ * month: 31.01.2024, 29.02.2024, 31.03.2024, 30.04.2024.
+ * R_MONTHS_OVERCAP: each date is the previous one shifted by step months, day
+ * that does not exist runs over into the next month and stays there:
+ * 31.01.2025, 03.03.2025, 03.04.2025. */
+class Schedule {
+ public:
+  enum Rule { R_DAYS, R_MONTHS, R_MONTHS_OVERCAP };
+
+  class Iterator;
+
+  typedef Iterator iterator;
+  typedef Iterator const_iterator;
+
+  constexpr Schedule() = default;
+  constexpr Schedule(Rule rule, int step, Date anchor, Date first, Date last)
+      : rule_(rule), step_(step), anchor_(anchor), first_(first),
+        last_(last) {}
+
+  constexpr Iterator begin() const;
+  constexpr Iterator end() const;
+
+ private:
+  Rule rule_ = R_DAYS;
+  int step_ = 1;
+  Date anchor_{1, 1, 1900};
+  Date first_{1, 1, 1900};
+  Date last_{1, 1, 1900};
+};
+
+class Schedule::Iterator {
+ public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef Date value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const Date* pointer;
+  typedef const Date& reference;
+
+  constexpr Iterator() = default;
+
+  constexpr reference operator*() const noexcept { return date_; }
+  constexpr pointer operator->() const noexcept { return &date_; }
+  constexpr Iterator& operator++();
+  constexpr Iterator operator++(int);
+  constexpr bool operator==(const Iterator& other) const noexcept {
+    return date_ == other.date_;
+  }
+  constexpr bool operator!=(const Iterator& other) const noexcept {
+    return date_ != other.date_;
+  }
+
+ private:
+  friend class Schedule;
+  constexpr Iterator(const Schedule& schedule, Date date, int index)
+      : schedule_(schedule), date_(date), index_(index) {}
+
+  Schedule schedule_{};
+  /* The day after 'last' when range is over. */
+  Date date_{1, 1, 1900};
+  int index_ = 0;
+};
+
+/* Dates before 'first' are skipped: by division for R_DAYS, one by one for
+ * months, as overcapped dates depend on all previous ones. */
+constexpr Schedule::Iterator Schedule::begin() const {
+  Iterator it(*this, anchor_, 0);
+  if (rule_ == R_DAYS && anchor_ < first_) {
+    it.index_ = ((first_ | anchor_) + step_ - 1) / step_;
+    it.date_ = anchor_ + it.index_ * step_;
+  }
+  while (it.date_ < first_ && it.date_ <= last_) ++it;
+  if (it.date_ > last_) it.date_ = last_ + 1;
+  return it;
+}
+
+constexpr Schedule::Iterator Schedule::end() const {
+  return Iterator(*this, last_ + 1, 0);
+}
+
+constexpr Schedule::Iterator& Schedule::Iterator::operator++() {
+  ++index_;
+  if (schedule_.rule_ == R_DAYS)
+    date_ += schedule_.step_;
+  else if (schedule_.rule_ == R_MONTHS)
+    date_ = schedule_.anchor_.shiftMonths(index_ * schedule_.step_);
+  else
+    date_ = date_.shiftMonthsOvercap(schedule_.step_);
+  if (date_ > schedule_.last_) date_ = schedule_.last_ + 1;
+  return *this;
+}
+
+constexpr Schedule::Iterator Schedule::Iterator::operator++(int) {
+  Iterator previous = *this;
+  ++*this;
+  return previous;
+}
+
+/* Serial day of date by algorithm of H. Hinnant: year is counted from March,
+ * so leap day is the last one, and split into 400-year eras of 146097 days. */
+constexpr int Date::daysFromCivil(int day, int month, int year) noexcept {
+  year -= month <= 2 ? 1 : 0;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const int year_of_era = year - era * 400;
+  const int day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+                          day - 1;
+  const int day_of_era = year_of_era * 365 + year_of_era / 4 -
+                         year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468 - BASE_OFFSET;
+}
+
+constexpr Date::Civil Date::civilFromDays(int serial) noexcept {
+  const int days = serial + BASE_OFFSET + 719468;
+  const int era = (days >= 0 ? days : days - 146096) / 146097;
+  const int day_of_era = days - era * 146097;
+  const int year_of_era = (day_of_era - day_of_era / 1460 +
+                           day_of_era / 36524 - day_of_era / 146096) /
+                          365;
+  const int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 -
+                                        year_of_era / 100);
+  const int month_from_march = (5 * day_of_year + 2) / 153;
+  const int month =
+      month_from_march < 10 ? month_from_march + 3 : month_from_march - 9;
+  return Civil{day_of_year - (153 * month_from_march + 2) / 5 + 1, month,
+               year_of_era + era * 400 + (month <= 2 ? 1 : 0)};
+}
+
+constexpr void Date::setDate(int day, int month, int year) {
+  if (isDateValid(day, month, year) == false)
+    throw std::invalid_argument("Invalid date.");
+  serial_ = daysFromCivil(day, month, year);
+}
+
+constexpr int Date::getDay() const noexcept {
+  return civilFromDays(serial_).day;
+}
+
+constexpr int Date::getMonth() const noexcept {
+  return civilFromDays(serial_).month;
+}
+
+constexpr int Date::getYear() const noexcept {
+  return civilFromDays(serial_).year;
+}
+
+/* BASE date is Monday. */
+constexpr int Date::getWeekday() const noexcept {
+  return (serial_ % 7 + 7) % 7 + 1;
+}
+
+constexpr int Date::getSerial() const noexcept { return serial_; }
+
+constexpr Date Date::fromSerial(int serial) noexcept {
+  Date date(BASE_DAY, BASE_MONTH, BASE_YEAR);
+  date.serial_ = serial;
+  return date;
+}
+
+constexpr int Date::monthBucket(int month, int year) noexcept {
+  return year * 12 + month - 1;
+}
+
+constexpr int Date::subtract(const Date& sub) const noexcept {
+  return serial_ - sub.serial_;
+}
+
+constexpr int Date::operator|(const Date& sub) const noexcept {
+  return subtract(sub);
+}
+
+constexpr Date operator+(int days, const Date& date) noexcept {
+  Date date_new(date);
+  date_new.addDays(days);
+  return date_new;
+}
+
+constexpr Date Date::operator+(int days) const noexcept {
+  Date date_new(*this);
+  date_new.addDays(days);
+  return date_new;
+}
+
+constexpr Date Date::operator-(int days) const noexcept {
+  Date date_new(*this);
+  date_new.addDays(-days);
+  return date_new;
+}
+
+constexpr Date Date::operator+=(int days) noexcept {
+  addDays(days);
+  return *this;
+}
+
+constexpr Date Date::operator-=(int days) noexcept {
+  addDays(-days);
+  return *this;
+}
+
+constexpr Date Date::operator++(int) noexcept {
+  addDays(1);
+  return *this;
+}
+
+constexpr Date Date::operator--(int) noexcept {
+  addDays(-1);
+  return *this;
+}
+
+constexpr Date Date::operator++() noexcept {
+  addDays(1);
+  return *this;
+}
+
+constexpr Date Date::operator--() noexcept {
+  addDays(-1);
+  return *this;
+}
+
+constexpr bool Date::operator==(const Date& date) const noexcept {
+  return serial_ == date.serial_;
+}
+
+constexpr bool Date::operator!=(const Date& date) const noexcept {
+  return serial_ != date.serial_;
+}
+
+constexpr bool Date::operator>=(const Date& date) const noexcept {
+  return serial_ >= date.serial_;
+}
+
+constexpr bool Date::operator<=(const Date& date) const noexcept {
+  return serial_ <= date.serial_;
+}
+
+constexpr bool Date::operator>(const Date& date) const noexcept {
+  return serial_ > date.serial_;
+}
+
+constexpr bool Date::operator<(const Date& date) const noexcept {
+  return serial_ < date.serial_;
+}
+
+constexpr void Date::addDays(int days) noexcept { serial_ += days; }
+
+/* Day is clipped to the last day of new month. */
+constexpr void Date::addMonths(int months) {
+  Civil date = civilFromDays(serial_);
+  int total = date.year * 12 + date.month - 1 + months;
+  int new_year = (total >= 0 ? total : total - 11) / 12;
+  int new_month = total - new_year * 12 + 1;
+  setDate(std::min(date.day, daysInMonth(new_month, new_year)), new_month,
+          new_year);
+}
+
+/* 29 February goes to 28 February of not leap year. */
+constexpr void Date::addYears(int years) {
+  Civil date = civilFromDays(serial_);
+  int new_year = date.year + years;
+  setDate(std::min(date.day, daysInMonth(date.month, new_year)), date.month,
+          new_year);
+}
+
+constexpr Date Date::shiftMonths(int months) const {
+  Date ret = *this;
+  ret.addMonths(months);
+  return ret;
+}
+
+/* Days cut by clipping are added back: 31.01.2025 + 1 month = 03.03.2025. */
+constexpr Date Date::shiftMonthsOvercap(int months) const {
+  Date ret = shiftMonths(months);
+  ret.serial_ += getDay() - ret.getDay();
+  return ret;
+}
+
+constexpr bool Date::isDateValid(int d, int m, int y) noexcept {
+  return y >= BASE_YEAR && m >= 1 && m <= 12 && d >= 1 &&
+         d <= daysInMonth(m, y);
+}
+
+constexpr int Date::daysInMonth(int m, int y) noexcept {
+  if (m == 2)
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0 ? 29 : 28;
+  return m == 4 || m == 6 || m == 9 || m == 11 ? 30 : 31;
+}
+
+/* Layout is told by separator after the first two characters. */
+constexpr bool Date::parse(std::string_view text, Date& date) noexcept {
+  if (text.size() != 10) return false;
+  int day = 0, month = 0, year = 0;
+  if (text[2] == '.' && text[5] == '.') {
+    day = readDigits(text, 0, 2);
+    month = readDigits(text, 3, 2);
+    year = readDigits(text, 6, 4);
+  } else if (text[4] == '-' && text[7] == '-') {
+    year = readDigits(text, 0, 4);
+    month = readDigits(text, 5, 2);
+    day = readDigits(text, 8, 2);
+  } else {
+    return false;
+  }
+  if (isDateValid(day, month, year) == false) return false;
+  date.serial_ = daysFromCivil(day, month, year);
+  return true;
+}
+
+constexpr char* Date::format(char* buffer, Style style) const noexcept {
+  Civil date = civilFromDays(serial_);
+  if (style == ISO) {
+    buffer = writeDigits(buffer, date.year, 4);
+    *buffer++ = '-';
+    buffer = writeDigits(buffer, date.month, 2);
+    *buffer++ = '-';
+    buffer = writeDigits(buffer, date.day, 2);
+  } else {
+    buffer = writeDigits(buffer, date.day, 2);
+    *buffer++ = '.';
+    buffer = writeDigits(buffer, date.month, 2);
+    *buffer++ = '.';
+    buffer = writeDigits(buffer, date.year, 4);
+  }
+  *buffer = '\0';
+  return buffer;
+}
+
+constexpr int Date::readDigits(std::string_view text, size_t first,
+                               size_t count) noexcept {
+  int value = 0;
+  for (size_t i = first; i < first + count; ++i) {
+    if (text[i] < '0' || text[i] > '9') return -1;
+    value = value * 10 + (text[i] - '0');
+  }
+  return value;
+}
+
+/* Value is padded by zeros to 'count' digits, longer one is written whole. */
+constexpr char* Date::writeDigits(char* buffer, int value,
+                                  int count) noexcept {
+  unsigned rest = value < 0 ? 0u : static_cast<unsigned>(value);
+  int length = 1;
+  for (unsigned i = rest; i >= 10; i /= 10) length++;
+  if (length < count) length = count;
+  for (int i = length - 1; i >= 0; --i, rest /= 10)
+    buffer[i] = static_cast<char>('0' + rest % 10);
+  return buffer + length;
+}
+
+/* Business days: weekdays of 'weekend' mask, one-off holidays and annual
+ * holidays are not business days. Annual holiday on weekend can also close
+ * observed day by its Observance rule. Days of years from 'first_year' to
+ * 'last_year' are kept in bitset per year, so check is O(1); dates out of it
+ * are checked by rules directly. Table is rebuilt on every rule change, so
+ * const methods may be called from several threads. */
+class Calendar {
+ public:
+  enum Adjustment { A_NONE, A_FOLLOWING, A_PRECEDING, A_MODIFIED_FOLLOWING };
+  /* OB_NEXT_WEEKDAY: the first day after holiday that is not weekend.
+   * OB_NEAREST_WEEKDAY: the day before if it is not weekend, otherwise the
+   * next one that is not weekend, like Saturday to Friday and Sunday to
+   * Monday. */
+  enum Observance { OB_NONE, OB_NEXT_WEEKDAY, OB_NEAREST_WEEKDAY };
+
+  /* Bit 'weekday' is set for weekend days, 1 is Monday. */
+  static constexpr unsigned SATURDAY_SUNDAY = (1 << 6) | (1 << 7);
+  static constexpr int FIRST_YEAR = 1900;
+  static constexpr int LAST_YEAR = 2200;
+  /* Adjustment looks no further than this number of days. */
+  static constexpr int MAX_SHIFT = 366;
+
+  /* Saturday and Sunday are weekend, no holidays. */
+  Calendar() = default;
+  Calendar(int first_year, int last_year);
+  ~Calendar() = default;
+
+  /* Returns false if mask has no business day in week. */
+  bool setWeekend(unsigned mask);
+  void addHoliday(Date date);
+  /* Returns false if there is no such day in any year. */
+  bool addAnnualHoliday(int day, int month, Observance observance = OB_NONE);
+  void clearHolidays();
+
+  unsigned getWeekend() const noexcept;
+  bool isWeekend(Date date) const noexcept;
+  bool isBusinessDay(Date date) const;
+  /* Date is returned as is if no business day is found in MAX_SHIFT days. */
+  Date adjust(Date date, Adjustment adjustment) const;
+
+ private:
+  struct Annual {
+    int day;
+    int month;
+    Observance observance;
+  };
+
+  int first_year_ = FIRST_YEAR;
+  int last_year_ = LAST_YEAR;
+  unsigned weekend_ = SATURDAY_SUNDAY;
+  std::vector<Date> holidays_{};
+  std::vector<Annual> annual_{};
+  /* Bit of day of year is set for day that is not business one. Empty until
+   * the first rule is added. */
+  std::vector<std::bitset<366>> years_{};
 
-  int getDaysSinceBase() const;
-  int getDiff(const struct std::tm& end, const struct std::tm& start) const;
+  void build();
+  void mark(Date date);
+  bool isClosedByRules(Date date) const;
+  Date observed(const Annual& annual, int year) const;
+  Date roll(Date date, int direction) const;
 };
 
 }  // namespace s21
@@ -11,11 +11,16 @@ void Credit::SetStartDate(int month, int year) {
   start_month_ = month;
   start_year_ = year;
 }
+void Credit::SetPaymentDay(int day) noexcept { payment_day_ = day; }
+void Credit::SetCalendar(const Calendar& calendar,
+                         Calendar::Adjustment adjustment) {
+  calendar_ = calendar;
+  adjustment_ = adjustment;
+}
 void Credit::SetStartDate() {
-  time_t t = std::time(NULL);
-  struct tm time_data = *std::localtime(&t);
-  start_month_ = time_data.tm_mon + 1;
-  start_year_ = time_data.tm_year + 1900;
+  Date today;
+  start_month_ = today.getMonth();
+  start_year_ = today.getYear();
 }
 
 Credit::Type Credit::GetType() const noexcept { return payment_type_; }
@@ -24,6 +29,10 @@ double Credit::GetRate() const noexcept { return rate_; }
 double Credit::GetCredit() const noexcept { return credit_; }
 int Credit::GetStartMonth() const noexcept { return start_month_; }
 int Credit::GetStartYear() const noexcept { return start_year_; }
+int Credit::GetPaymentDay() const noexcept { return payment_day_; }
+Calendar::Adjustment Credit::GetAdjustment() const noexcept {
+  return adjustment_;
+}
 double Credit::GetSummaryPaid() const noexcept { return sum_paid_; }
 double Credit::GetSummaryMainPart() const noexcept { return sum_main_paid_; }
 double Credit::GetSummaryRatePart() const noexcept { return sum_rate_paid_; }
@@ -48,6 +57,7 @@ bool Credit::Calculate() {
       CalculateAnnuity();
     else
       CalculateDifferential();
+    SetPaymentDates();
     return true;
   }
   return false;
@@ -64,7 +74,7 @@ void Credit::Reset() noexcept {
 
 bool Credit::Validate() const noexcept {
   return ValidateCredit() && ValidateRate() && ValidateTime() &&
-         ValidateStartDate();
+         ValidateStartDate() && ValidatePaymentDay();
 }
 
 bool Credit::ValidateCredit() const noexcept {
@@ -86,6 +96,10 @@ bool Credit::ValidateStartDate() const noexcept {
          start_year_ <= MAX_YEAR_;
 }
 
+bool Credit::ValidatePaymentDay() const noexcept {
+  return payment_day_ >= 1 && payment_day_ <= 31;
+}
+
 void Credit::CalculateAnnuity() noexcept {
   data_[0].month_ = start_month_;
   data_[0].year_ = start_year_;
@@ -148,6 +162,20 @@ void Credit::CalculateSummary() noexcept {
   }
 }
 
+/* Months are counted first, then payment day is put into each of them and
+ * moved by calendar, so payment may go to the neighbour month. */
+void Credit::SetPaymentDates() {
+  for (CreditMonth& month : data_) {
+    Date date(std::min(payment_day_,
+                       Date::daysInMonth(month.month_, month.year_)),
+              month.month_, month.year_);
+    date = calendar_.adjust(date, adjustment_);
+    month.day_ = date.getDay();
+    month.month_ = date.getMonth();
+    month.year_ = date.getYear();
+  }
+}
+
 void Credit::RoundData() noexcept {
   for (int i = 0; i < time_; ++i) {
     data_[i].main_fee_ = bankRoundTwoDecimal(data_[i].main_fee_);
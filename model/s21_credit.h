@@ -19,6 +19,8 @@ class Credit {
     CreditMonth() = default;
     ~CreditMonth() = default;
 
+    /* Date of payment. */
+    int GetDay() const noexcept { return day_; }
     int GetMonth() const noexcept { return month_; }
     int GetYear() const noexcept { return year_; }
     double GetPayment() const noexcept { return payment_; }
@@ -27,6 +29,7 @@ class Credit {
     double GetLeftover() const noexcept { return leftover_; }
 
    private:
+    int day_;
     int month_;
     int year_;
     double payment_;
@@ -45,6 +48,10 @@ class Credit {
   void SetCredit(double credit) noexcept;
   void SetStartDate();
   void SetStartDate(int month, int year);
+  /* Day of month to pay, clipped to the last day of shorter months. */
+  void SetPaymentDay(int day) noexcept;
+  /* Payment that falls on non-business day is moved by calendar. */
+  void SetCalendar(const Calendar& calendar, Calendar::Adjustment adjustment);
 
   /* Get methods */
   Type GetType() const noexcept;
@@ -53,6 +60,8 @@ class Credit {
   double GetCredit() const noexcept;
   int GetStartMonth() const noexcept;
   int GetStartYear() const noexcept;
+  int GetPaymentDay() const noexcept;
+  Calendar::Adjustment GetAdjustment() const noexcept;
   double GetSummaryPaid() const noexcept;
   double GetSummaryMainPart() const noexcept;
   double GetSummaryRatePart() const noexcept;
@@ -69,6 +78,9 @@ class Credit {
 
  private:
   int start_month_ = 0, start_year_ = 0;
+  int payment_day_ = 1;
+  Calendar calendar_{};
+  Calendar::Adjustment adjustment_ = Calendar::A_NONE;
   double credit_ = 0.0;
   int time_ = 0;
   double rate_ = 0;
@@ -84,9 +96,11 @@ class Credit {
   bool ValidateRate() const noexcept;
   bool ValidateTime() const noexcept;
   bool ValidateStartDate() const noexcept;
+  bool ValidatePaymentDay() const noexcept;
   void CalculateAnnuity() noexcept;
   void CalculateDifferential() noexcept;
   void CalculateSummary() noexcept;
+  void SetPaymentDates();
   void RoundData() noexcept;
 };
 
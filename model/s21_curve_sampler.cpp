@@ -0,0 +1,100 @@
+#include "s21_curve_sampler.h"
+
+#include <cmath>
+
+namespace s21 {
+
+CurveSampler::CurveSampler(const Options& options) : options_(options) {}
+
+std::vector<CurveSampler::Point> CurveSampler::Sample(
+    const Evaluator& evaluate, double t_min, double t_max) const {
+  std::vector<Point> points;
+  size_t count = options_.initial_count < 2 ? 2 : options_.initial_count;
+  if (!(t_max > t_min) || std::isfinite(t_max - t_min) == false) return points;
+  double step = (t_max - t_min) / (count - 1);
+  for (size_t i = 0; i < count; ++i)
+    points.push_back(Point{t_min + i * step, NAN, NAN});
+  points.back().t = t_max;
+  if (Evaluate(evaluate, points) == false) return points;
+
+  std::vector<Point> middles;
+  std::vector<Point> merged;
+  for (int round = 0; round < options_.max_rounds; ++round) {
+    middles.clear();
+    for (size_t i = 0; i + 1 < points.size(); ++i) {
+      if (points.size() + middles.size() >= options_.max_count) break;
+      if (NeedSplit(points, i) == true)
+        middles.push_back(
+            Point{points[i].t + (points[i + 1].t - points[i].t) / 2, NAN, NAN});
+    }
+    if (middles.empty() == true) break;
+    if (Evaluate(evaluate, middles) == false) break;
+    merged.clear();
+    merged.reserve(points.size() + middles.size());
+    size_t m = 0;
+    for (const Point& point : points) {
+      while (m < middles.size() && middles[m].t < point.t)
+        merged.push_back(middles[m++]);
+      merged.push_back(point);
+    }
+    points.swap(merged);
+  }
+  return points;
+}
+
+bool CurveSampler::Evaluate(const Evaluator& evaluate,
+                            std::vector<Point>& points) const {
+  std::vector<double> t(points.size()), x(points.size()), y(points.size());
+  for (size_t i = 0; i < points.size(); ++i) t[i] = points[i].t;
+  if (evaluate(t.data(), x.data(), y.data(), points.size()) == false)
+    return false;
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i].x = x[i];
+    points[i].y = y[i];
+  }
+  return true;
+}
+
+/* Segment between points i and i + 1 is split if it is too long, if curve
+ * turns sharply at its ends, or if only one of its ends is defined, so the
+ * border of domain is found more precisely. */
+bool CurveSampler::NeedSplit(const std::vector<Point>& points,
+                             size_t i) const {
+  const Point& a = points[i];
+  const Point& b = points[i + 1];
+  if (!(b.t - a.t > std::fabs(a.t) * 1e-12)) return false;
+  bool finite_a = IsFinite(a), finite_b = IsFinite(b);
+  if (finite_a != finite_b) return true;
+  if (finite_a == false) return false;
+  double length = Length(a, b);
+  if (length > options_.max_length) return true;
+  if (length <= options_.min_length) return false;
+  if (i > 0 && IsFinite(points[i - 1]) &&
+      Turn(points[i - 1], a, b) > options_.max_angle)
+    return true;
+  if (i + 2 < points.size() && IsFinite(points[i + 2]) &&
+      Turn(a, b, points[i + 2]) > options_.max_angle)
+    return true;
+  return false;
+}
+
+double CurveSampler::Length(const Point& a, const Point& b) const noexcept {
+  return std::hypot((b.x - a.x) / options_.scale_x,
+                    (b.y - a.y) / options_.scale_y);
+}
+
+/* Angle between segments ab and bc. */
+double CurveSampler::Turn(const Point& a, const Point& b,
+                          const Point& c) const noexcept {
+  double x1 = (b.x - a.x) / options_.scale_x;
+  double y1 = (b.y - a.y) / options_.scale_y;
+  double x2 = (c.x - b.x) / options_.scale_x;
+  double y2 = (c.y - b.y) / options_.scale_y;
+  return std::fabs(std::atan2(x1 * y2 - y1 * x2, x1 * x2 + y1 * y2));
+}
+
+bool CurveSampler::IsFinite(const Point& point) noexcept {
+  return std::isfinite(point.x) && std::isfinite(point.y);
+}
+
+}  // namespace s21
@@ -0,0 +1,63 @@
+#ifndef S21_CURVE_SAMPLER_H
+#define S21_CURVE_SAMPLER_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace s21 {
+
+/* Adaptive sampling of plane curve (x(t), y(t)). Starts with uniform grid of
+ * parameter values, then on every round splits segments that are too long or
+ * where curve turns sharply. Points of one round are evaluated in one batch.
+ * Lengths are measured in units of scale_x and scale_y, i.e. pixels, so
+ * straight runs stay coarse, while tight loops get more points. */
+class CurveSampler {
+ public:
+  struct Point {
+    double t;
+    double x;
+    double y;
+  };
+
+  struct Options {
+    size_t initial_count = 64;
+    size_t max_count = 16384;
+    int max_rounds = 16;
+    double scale_x = 1.0;
+    double scale_y = 1.0;
+    /* Segment longer than max_length is always split. */
+    double max_length = 32.0;
+    /* Segment longer than min_length is split if curve turns by more than
+     * max_angle radians at one of its ends. */
+    double min_length = 1.0;
+    double max_angle = 0.1;
+  };
+
+  /* Evaluate 'count' points with parameters 't' into 'x' and 'y'. Returning
+   * false stops sampling, e.g. when request is cancelled. */
+  typedef std::function<bool(const double* t, double* x, double* y,
+                             size_t count)>
+      Evaluator;
+
+  CurveSampler() = default;
+  explicit CurveSampler(const Options& options);
+  ~CurveSampler() = default;
+
+  /* Returns points ordered by t. Non-finite points are kept as gaps. */
+  std::vector<Point> Sample(const Evaluator& evaluate, double t_min,
+                            double t_max) const;
+
+ private:
+  Options options_{};
+
+  bool Evaluate(const Evaluator& evaluate, std::vector<Point>& points) const;
+  bool NeedSplit(const std::vector<Point>& points, size_t i) const;
+  double Length(const Point& a, const Point& b) const noexcept;
+  double Turn(const Point& a, const Point& b, const Point& c) const noexcept;
+  static bool IsFinite(const Point& point) noexcept;
+};
+
+}  // namespace s21
+
+#endif  // S21_CURVE_SAMPLER_H
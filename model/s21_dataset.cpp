@@ -0,0 +1,209 @@
+#include "s21_dataset.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace s21 {
+
+Dataset::~Dataset() { Close(); }
+
+bool Dataset::Open(const std::string& path, Format format, size_t column,
+                   size_t columns, char separator) {
+  Close();
+  format_ = format;
+  column_ = column;
+  columns_ = columns;
+  separator_ = separator;
+  if (format == BINARY && column >= columns) {
+    status_ = FORMAT_ERROR;
+    return false;
+  }
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    status_ = OPEN_ERROR;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    status_ = OPEN_ERROR;
+    return false;
+  }
+  size_ = static_cast<size_t>(info.st_size);
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      size_ = 0;
+      status_ = OPEN_ERROR;
+      return false;
+    }
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+  }
+  close(fd);
+  if (format == BINARY && size_ % (sizeof(double) * columns) != 0) {
+    Close();
+    status_ = FORMAT_ERROR;
+    return false;
+  }
+  status_ = READY;
+  return true;
+}
+
+void Dataset::Close() noexcept {
+  if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+  data_ = nullptr;
+  size_ = 0;
+  status_ = EMPTY;
+}
+
+Dataset::Status Dataset::GetStatus() const noexcept { return status_; }
+
+bool Dataset::Read(const Consumer& consumer) {
+  auto block = [&consumer](const double* x, size_t count) {
+    consumer(x, x, count);
+  };
+  if (status_ != READY) return false;
+  return format_ == CSV ? ReadCsv(block) : ReadBinary(block);
+}
+
+/* Expression is checked once with empty block, so every block of column is
+ * evaluated successfully. */
+bool Dataset::Evaluate(const Calculation& calculation,
+                       const Consumer& consumer) {
+  if (status_ != READY ||
+      calculation.GetResults(nullptr, nullptr, 0) == false)
+    return false;
+  std::vector<double> results(BLOCK_SIZE);
+  auto block = [&](const double* x, size_t count) {
+    calculation.GetResults(x, results.data(), count);
+    consumer(x, results.data(), count);
+  };
+  return format_ == CSV ? ReadCsv(block) : ReadBinary(block);
+}
+
+bool Dataset::Evaluate(const Calculation& calculation,
+                       Statistics& statistics) {
+  return Evaluate(calculation, [&statistics](const double*, const double* y,
+                                             size_t count) {
+    statistics.Add(y, count);
+  });
+}
+
+bool Dataset::Evaluate(const Calculation& calculation, Histogram& histogram) {
+  return Evaluate(calculation,
+                  [&histogram](const double*, const double* y, size_t count) {
+                    histogram.Add(y, count);
+                  });
+}
+
+bool Dataset::ReadCsv(
+    const std::function<void(const double*, size_t)>& block) {
+  std::vector<double> values(BLOCK_SIZE);
+  size_t count = 0;
+  bool first = true;
+  const char* end = data_ + size_;
+  for (const char* line = data_; line < end;) {
+    const char* eol =
+        static_cast<const char*>(std::memchr(line, '\n', end - line));
+    if (eol == nullptr) eol = end;
+    const char* next = eol + (eol < end ? 1 : 0);
+    if (eol > line && eol[-1] == '\r') eol--;
+    if (eol == line) {
+      line = next;
+      continue;
+    }
+    const char* field = line;
+    for (size_t i = 0; i < column_ && field != nullptr; ++i) {
+      field = static_cast<const char*>(
+          std::memchr(field, separator_, eol - field));
+      if (field != nullptr) field++;
+    }
+    double value = NAN;
+    bool parsed = false;
+    if (field != nullptr) {
+      const char* field_end = static_cast<const char*>(
+          std::memchr(field, separator_, eol - field));
+      parsed = ParseField(field, field_end ? field_end : eol, value);
+    }
+    if (parsed == true || first == false) {
+      values[count++] = value;
+      if (count == BLOCK_SIZE) {
+        block(values.data(), count);
+        count = 0;
+      }
+    }
+    first = false;
+    line = next;
+  }
+  if (count > 0) block(values.data(), count);
+  return true;
+}
+
+/* Single column is passed straight from mapped memory, which is page
+ * aligned. */
+bool Dataset::ReadBinary(
+    const std::function<void(const double*, size_t)>& block) {
+  size_t rows = size_ / (sizeof(double) * columns_);
+  if (columns_ == 1) {
+    const double* values = reinterpret_cast<const double*>(data_);
+    for (size_t row = 0; row < rows; row += BLOCK_SIZE)
+      block(values + row, std::min(BLOCK_SIZE, rows - row));
+    return true;
+  }
+  std::vector<double> values(BLOCK_SIZE);
+  size_t count = 0;
+  for (size_t row = 0; row < rows; ++row) {
+    std::memcpy(&values[count++],
+                data_ + (row * columns_ + column_) * sizeof(double),
+                sizeof(double));
+    if (count == BLOCK_SIZE) {
+      block(values.data(), count);
+      count = 0;
+    }
+  }
+  if (count > 0) block(values.data(), count);
+  return true;
+}
+
+/* Field must be a number surrounded only by spaces. Standard libraries
+ * without std::from_chars for double, e.g. libc++ of older macOS toolchains,
+ * parse a copy of the field by strtod with the point of current locale. */
+bool Dataset::ParseField(const char* begin, const char* end,
+                         double& value) const {
+  while (begin < end && (*begin == ' ' || *begin == '\t')) begin++;
+  while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) end--;
+  if (begin < end && *begin == '+') begin++;
+#ifdef __cpp_lib_to_chars
+  std::from_chars_result result = std::from_chars(begin, end, value);
+  return begin < end && result.ec == std::errc() && result.ptr == end;
+#else
+  char field[FIELD_SIZE];
+  size_t size = end - begin;
+  if (size == 0 || size >= FIELD_SIZE || *begin == '+') return false;
+  std::memcpy(field, begin, size);
+  field[size] = '\0';
+  char* point = std::strchr(field, '.');
+  if (point != nullptr) *point = *std::localeconv()->decimal_point;
+  char* last = nullptr;
+  errno = 0;
+  double parsed = std::strtod(field, &last);
+  if (last != field + size || errno == ERANGE) return false;
+  value = parsed;
+  return true;
+#endif
+}
+
+}  // namespace s21
@@ -0,0 +1,68 @@
+#ifndef S21_DATASET_H
+#define S21_DATASET_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "s21_calculation.h"
+#include "s21_statistics.h"
+
+namespace s21 {
+
+/* Column of numbers in file, mapped into memory. File is read by blocks of
+ * BLOCK_SIZE values, so column is never stored whole.
+ * CSV: one row per line, fields are separated by 'separator'. The first line
+ * is skipped if its field is not a number, e.g. header. Other fields that are
+ * not numbers give NaN.
+ * BINARY: rows of 'columns' native doubles without any header. */
+class Dataset {
+ public:
+  enum Format { CSV, BINARY };
+  enum Status { EMPTY, READY, OPEN_ERROR, FORMAT_ERROR };
+
+  static constexpr size_t BLOCK_SIZE = 4096;
+
+  /* Receives column values and results of expression by blocks. */
+  typedef std::function<void(const double* x, const double* y, size_t count)>
+      Consumer;
+
+  Dataset() = default;
+  ~Dataset();
+  Dataset(const Dataset&) = delete;
+  Dataset& operator=(const Dataset&) = delete;
+
+  bool Open(const std::string& path, Format format, size_t column = 0,
+            size_t columns = 1, char separator = ',');
+  void Close() noexcept;
+  Status GetStatus() const noexcept;
+
+  /* Pass column by blocks to consumer, results are the same values. */
+  bool Read(const Consumer& consumer);
+  /* Evaluate compiled expression for column used as x. Returns false if
+   * expression is not compiled or invalid. */
+  bool Evaluate(const Calculation& calculation, const Consumer& consumer);
+  bool Evaluate(const Calculation& calculation, Statistics& statistics);
+  /* Range of histogram is usually taken from Statistics of previous pass. */
+  bool Evaluate(const Calculation& calculation, Histogram& histogram);
+
+ private:
+  /* Longest number field parsed without std::from_chars. */
+  static constexpr size_t FIELD_SIZE = 128;
+
+  Status status_ = EMPTY;
+  Format format_ = CSV;
+  size_t column_ = 0;
+  size_t columns_ = 1;
+  char separator_ = ',';
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+  bool ReadCsv(const std::function<void(const double*, size_t)>& block);
+  bool ReadBinary(const std::function<void(const double*, size_t)>& block);
+  bool ParseField(const char* begin, const char* end, double& value) const;
+};
+
+}  // namespace s21
+
+#endif  // S21_DATASET_H
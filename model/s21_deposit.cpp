@@ -48,12 +48,20 @@ void Deposit::popBackWithdrawal() noexcept {
 }
 void Deposit::clearReplenish() noexcept { replenish_list_.clear(); }
 void Deposit::clearWithdrawal() noexcept { withdrawal_list_.clear(); }
+void Deposit::setCalendar(const Calendar& calendar,
+                          Calendar::Adjustment adjustment) {
+  calendar_ = calendar;
+  adjustment_ = adjustment;
+}
 
 /* Methods to look at some user variables. No bound checking. */
 
 bool Deposit::isCapitalization() const noexcept { return capital_; }
 double Deposit::getDeposit() const noexcept { return deposit_; }
 double Deposit::getRemainderLimit() const noexcept { return remainder_limit_; }
+Calendar::Adjustment Deposit::getAdjustment() const noexcept {
+  return adjustment_;
+}
 size_t Deposit::getReplenishListSize() const noexcept {
   return replenish_list_.size();
 }
@@ -90,28 +98,18 @@ double Deposit::getWithdrawalTotal() const noexcept {
 }
 
 /* Main method to run. Provides bound checking. */
-/* Return false if user parameters are invalid.
-  Weak part: function strictly rely on events order after sorting - some
-  std::sort realization doesn't ensure that equal elements won't move, in that
-  case output data can have wrong order and hence be calculated incorrectly.  */
-bool Deposit::calculate() {
+/* Return false if user parameters are invalid. Summary of deposit without
+ * operations and calendar is calculated by periods, other summaries are
+ * counted event by event without storing them. */
+bool Deposit::calculate(Mode mode) {
   if (validateSettings() == false) return false;
   setDefaultValues();
   calculateEndDate();
-  insertDeposit();
-  insertReplenishList();
-  insertWithdrawalList();
-  insertPaydays();
-  insertNewYears();
-  insertLastPayday();
-
-  std::sort(event_list_.begin(), event_list_.end(), dateComparator);
-
-  /* Splice replenishments and withdrawals of the same day. Set 'false', if full
-   * representation is needed. */
-  fixEventList(true);
-
-  calculateValues();
+  if (mode == M_SUMMARY_ONLY && replenish_list_.empty() &&
+      withdrawal_list_.empty() && adjustment_ == Calendar::A_NONE)
+    calculateSummary();
+  else
+    calculateEvents(mode);
   return true;
 }
 
@@ -119,6 +117,9 @@ bool Deposit::calculate() {
 
 void Deposit::setDefaultValues() noexcept {
   event_list_.clear();
+  pending_gains_.clear();
+  pending_gain_ = 0.0L;
+  event_count_ = 0;
   tax_list_.clear();
   balance_ = 0.0L;
   year_income_ = 0.0L;
@@ -133,98 +134,175 @@ void Deposit::calculateEndDate() {
   if (term_type_ == T_MONTH) {
     end_date_.addMonths(term_);
   } else if (term_type_ == T_YEAR) {
-    end_date_ = nextMonthDate(end_date_, term_ * 12);
+    end_date_ = end_date_.shiftMonthsOvercap(term_ * 12);
   } else {
     end_date_ += term_;
   }
 }
 
-void Deposit::calculateValues() {
-  countDayValue(start_date_.getYear());
-  for (std::vector<Event>::iterator i = event_list_.begin();
-       i != event_list_.end(); ++i) {
-    switch (i->event_) {
-      case E_REPLENISH:
-        countReplenish(i);
-        break;
-      case E_WITHDRAWAL:
-        countWithdrawal(i);
-        break;
-      case E_NEWYEAR:
-        countNewyear(i);
-        break;
-      case E_PAYDAY:
-        countPayday(i);
-        break;
+/* Events come from sorted sources: deposit, every replenishment and
+ * withdrawal in order of lists, paydays, new years and the last payday. They
+ * are merged by date, then by EventType, then by order of source, so the
+ * order does not depend on sort stability, and passed to 'emit' as type,
+ * date and value. Memory depends on number of sources only. */
+template <class Emit>
+void Deposit::mergeEvents(Emit emit) const {
+  std::vector<Source> sources;
+  addSource(sources, Source::S_FIXED, E_REPLENISH, deposit_,
+            Schedule(Schedule::R_DAYS, 1, start_date_, start_date_,
+                     start_date_));
+  addOperationSources(sources, replenish_list_, E_REPLENISH);
+  addOperationSources(sources, withdrawal_list_, E_WITHDRAWAL);
+  addPaydaySource(sources);
+  addSource(sources, Source::S_FIXED, E_NEWYEAR, 0.0L,
+            Schedule(Schedule::R_MONTHS, 12,
+                     Date(31, 12, start_date_.getYear()), start_date_,
+                     end_date_ - 1));
+  addSource(sources, Source::S_FIXED, E_PAYDAY, 0.0L,
+            Schedule(Schedule::R_DAYS, 1, end_date_, end_date_, end_date_));
+
+  auto later = [&sources](size_t first, size_t second) {
+    const Source& a = sources[first];
+    const Source& b = sources[second];
+    if (a.date != b.date) return a.date > b.date;
+    if (a.event != b.event) return a.event > b.event;
+    return first > second;
+  };
+  std::vector<size_t> heap;
+  for (size_t i = 0; i < sources.size(); ++i)
+    if (advanceSource(sources[i])) heap.push_back(i);
+  std::make_heap(heap.begin(), heap.end(), later);
+  while (heap.empty() == false) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    Source& source = sources[heap.back()];
+    emit(source.event, source.date, source.value);
+    if (advanceSource(source))
+      std::push_heap(heap.begin(), heap.end(), later);
+    else
+      heap.pop_back();
+  }
+}
 
-      default:
-        break;
+/* Merged events are counted one event behind, so operations of the same
+ * day are spliced into one event of sign of their sum before it is counted.
+ * The first event is deposit itself, it is kept apart. */
+void Deposit::calculateEvents(Mode mode) {
+  countDayValue(start_date_.getYear());
+  Step held;
+  bool holding = false;
+  mergeEvents([&](EventType event, Date date, long double change) {
+    if (event == E_WITHDRAWAL) change = -change;
+    if (holding && event_count_ > 0 && held.date == date &&
+        (event == E_REPLENISH || event == E_WITHDRAWAL) &&
+        (held.event == E_REPLENISH || held.event == E_WITHDRAWAL)) {
+      held.balance_change += change;
+      held.event = held.balance_change < 0.0L ? E_WITHDRAWAL : E_REPLENISH;
+      return;
     }
+    if (holding) countEvent(held, mode);
+    held = Step{event, date, 0.0L, change, 0.0L, 0.0L};
+    holding = true;
+  });
+  if (holding) countEvent(held, mode);
+}
+
+/* Gains of events between paydays are passed to the next payday, the last
+ * event is always a payday. */
+void Deposit::countEvent(Step& step, Mode mode) {
+  switch (step.event) {
+    case E_REPLENISH:
+      countReplenish(step);
+      break;
+    case E_WITHDRAWAL:
+      countWithdrawal(step);
+      break;
+    case E_NEWYEAR:
+      countNewyear(step);
+      break;
+    case E_PAYDAY:
+      countPayday(step, mode);
+      break;
+
+    default:
+      break;
   }
+  if (step.event != E_PAYDAY && event_count_ > 0) {
+    if (mode == M_FULL)
+      pending_gains_.push_back(step.gain);
+    else
+      pending_gain_ += step.gain;
+    step.gain = 0.0L;
+  }
+  last_date_ = step.date;
+  event_count_++;
+  if (mode == M_FULL)
+    event_list_.push_back(Event(step.event, step.date, step.gain,
+                                step.balance_change, step.payment,
+                                step.balance));
 }
 
-void Deposit::countReplenish(std::vector<Event>::iterator i) noexcept {
-  countGain(i);
-  countBalance(i);
-  if (i != event_list_.begin()) replenish_total_ += i->balance_change_;
+void Deposit::countReplenish(Step& step) noexcept {
+  countGain(step);
+  countBalance(step);
+  if (event_count_ > 0) replenish_total_ += step.balance_change;
 }
 
-void Deposit::countWithdrawal(std::vector<Event>::iterator i) noexcept {
-  countGain(i);
-  if (balance_ + i->balance_change_ >= remainder_limit_) {
-    countBalance(i);
-    withdrawal_total_ -= i->balance_change_;
+void Deposit::countWithdrawal(Step& step) noexcept {
+  countGain(step);
+  if (balance_ + step.balance_change >= remainder_limit_) {
+    countBalance(step);
+    withdrawal_total_ -= step.balance_change;
   } else {
-    i->balance_ = balance_;
-    i->event_ = E_DECLINE;
+    step.balance = balance_;
+    step.event = E_DECLINE;
   }
 }
 
-void Deposit::countNewyear(std::vector<Event>::iterator i) {
-  countGain(i);
-  countBalance(i);
-  countDayValue(i->date_.getYear() + 1);
-  if (i->date_ != start_date_) countTax(i);
+void Deposit::countNewyear(Step& step) {
+  countGain(step);
+  countBalance(step);
+  countDayValue(step.date.getYear() + 1);
+  if (step.date != start_date_) countTax(step.date.getYear());
 }
 
-void Deposit::countPayday(std::vector<Event>::iterator i) {
-  countGain(i);
-  sumPreviousGains(i);
+void Deposit::countPayday(Step& step, Mode mode) {
+  countGain(step);
+  if (mode == M_FULL) {
+    for (auto gain = pending_gains_.rbegin(); gain != pending_gains_.rend();
+         ++gain)
+      step.gain += *gain;
+    pending_gains_.clear();
+  } else {
+    step.gain += pending_gain_;
+    pending_gain_ = 0.0L;
+  }
   if (capital_ == true)
-    i->balance_change_ = i->gain_;
+    step.balance_change = step.gain;
   else
-    i->payment_ = i->gain_;
-  countBalance(i);
-  interest_total_ += i->gain_;
-  year_income_ += i->gain_;
-  if (i->date_ == end_date_) {
-    countTax(i);
+    step.payment = step.gain;
+  countBalance(step);
+  interest_total_ += step.gain;
+  year_income_ += step.gain;
+  if (step.date == end_date_) {
+    countTax(step.date.getYear());
   }
 }
 
-void Deposit::countBalance(std::vector<Event>::iterator i) noexcept {
-  balance_ += i->balance_change_;
-  i->balance_ = balance_;
+void Deposit::countBalance(Step& step) noexcept {
+  balance_ += step.balance_change;
+  step.balance = balance_;
 }
 
-/* CAREFUL. It looks back to previous element. */
-void Deposit::countGain(std::vector<Event>::iterator i) noexcept {
-  if (i > event_list_.begin())
-    i->gain_ = day_value_ * (i->date_ | (i - 1)->date_) * balance_;
-}
-
-void Deposit::sumPreviousGains(std::vector<Event>::iterator i) noexcept {
-  for (std::vector<Event>::iterator j = i - 1;
-       j->event_ != E_PAYDAY && j != event_list_.begin(); --j) {
-    i->gain_ += j->gain_;
-    j->gain_ = 0.0L;
-  }
+/* Gain since the previous event, there is none for the first one. */
+void Deposit::countGain(Step& step) noexcept {
+  if (event_count_ > 0)
+    step.gain = day_value_ * (step.date | last_date_) * balance_;
 }
 
-void Deposit::countTax(std::vector<Event>::iterator i) {
+void Deposit::countTax(int year) {
   long double gain = year_income_ * tax_;
   tax_total_ += gain;
-  tax_list_.push_back(Tax(i->date_.getYear(), year_income_, gain));
+  tax_list_.push_back(Tax(year, year_income_, gain));
   year_income_ = 0.0L;
 }
 
@@ -232,153 +310,188 @@ void Deposit::countDayValue(int year) noexcept {
   day_value_ = calculateDayValue(year, interest_);
 }
 
-/* Splice replenishments and withdrawals of the same day in event_list_. */
-/* Swap payday and new_year events of same day so new_year goes after payday. */
-void Deposit::fixEventList(bool splice_on) noexcept {
-  for (size_t i = 1; i < event_list_.size() - 1; ++i) {
-    if (splice_on == true) {
-      if (event_list_[i].date_ == event_list_[i + 1].date_ &&
-          (event_list_[i].event_ == E_REPLENISH ||
-           event_list_[i].event_ == E_WITHDRAWAL) &&
-          (event_list_[i + 1].event_ == E_REPLENISH ||
-           event_list_[i + 1].event_ == E_WITHDRAWAL)) {
-        spliceOperations(i, i + 1);
-        --i;
+/* The same steps as calculateEvents() for deposit, paydays, new years and
+ * the last payday, without events. Balance changes only on paydays, so
+ * daily and weekly paydays of one year after the first one are periods of
+ * equal gain factor and are applied at once by power of it. */
+void Deposit::calculateSummary() {
+  countDayValue(start_date_.getYear());
+  balance_ = deposit_;
+  Schedule::Rule rule = Schedule::R_DAYS;
+  int step = 0;
+  /* Empty schedule if interest is paid at the end of term only. */
+  Schedule paydays(Schedule::R_DAYS, 1, end_date_, end_date_, end_date_ - 1);
+  if (paydayRule(rule, step))
+    paydays = Schedule(rule, step, start_date_, start_date_ + 1, end_date_ - 1);
+  Schedule::Iterator payday = paydays.begin();
+  Date new_year(31, 12, start_date_.getYear());
+  Date last = start_date_;
+  /* Gain since the last payday. */
+  long double pending = 0.0L;
+  auto gainTo = [&](Date date) {
+    long double gain = day_value_ * (date | last) * balance_;
+    last = date;
+    return gain;
+  };
+  auto pay = [&](long double gain) {
+    if (capital_ == true) balance_ += gain;
+    interest_total_ += gain;
+    year_income_ += gain;
+  };
+
+  while (true) {
+    bool has_payday = payday != paydays.end();
+    bool has_new_year = new_year < end_date_;
+    if (has_payday && (has_new_year == false || *payday <= new_year)) {
+      pay(pending + gainTo(*payday));
+      pending = 0.0L;
+      Date limit = has_new_year ? new_year : end_date_ - 1;
+      int periods = rule == Schedule::R_DAYS ? (limit | last) / step : 0;
+      if (periods > 0) {
+        long double factor = 1.0L + day_value_ * step;
+        if (capital_ == true)
+          pay(balance_ * (std::pow(factor, periods) - 1.0L));
+        else
+          pay(day_value_ * step * balance_ * periods);
+        last += periods * step;
+        payday = Schedule(rule, step, start_date_, last + 1, end_date_ - 1)
+                     .begin();
+      } else {
+        ++payday;
       }
+    } else if (has_new_year) {
+      pending += gainTo(new_year);
+      countDayValue(new_year.getYear() + 1);
+      if (new_year != start_date_) countTax(new_year.getYear());
+      new_year = Date(31, 12, new_year.getYear() + 1);
+    } else {
+      break;
     }
   }
+  pay(pending + gainTo(end_date_));
+  countTax(end_date_.getYear());
 }
 
-void Deposit::spliceOperations(size_t first, size_t second) noexcept {
-  event_list_[first].balance_change_ += event_list_[second].balance_change_;
-  if (event_list_[first].balance_change_ < 0.0L)
-    event_list_[first].event_ = E_WITHDRAWAL;
-  else
-    event_list_[first].event_ = E_REPLENISH;
-  event_list_.erase(event_list_.begin() + second);
-}
-
-void Deposit::insertDeposit() { pushEvent(E_REPLENISH, start_date_, deposit_); }
-
-void Deposit::insertNewYears() {
-  for (int i = 0; i < end_date_.getYear() - start_date_.getYear(); i++) {
-    pushEvent(E_NEWYEAR, Date(31, 12, start_date_.getYear() + i));
-  }
-}
+/* Dates of operations and payments seems to be produced in unstable manner
+ * date-wise on calcus.ru when day is 29-31. The method is chosen depends on
+ * calcul.ru behaviour with different periodicity of operation (2 methods to
+ * skip months).
+ * R_MONTHS builds dates relatively to start date, cut days if needed.
+ * Example: 31.01.2024 + 1 month = 29.02.2024, 31.03.2024, 30.04.2024, etc.
+ * R_MONTHS_OVERCAP builds dates relatively to current date with possibility
+ * of overcapping by 1-3 days. Example: 29.02.2024 + 12 months = 01.03.2025,
+ * ... , 01.03.2028, etc. */
+void Deposit::addOperationSources(std::vector<Source>& sources,
+                                  const std::vector<Operation>& list,
+                                  EventType event) const {
+  for (const Operation& operation : list) {
+    Date date = operation.date_;
+    Schedule::Rule rule = Schedule::R_MONTHS;
+    int step = 0;
+    switch (operation.period_) {
+      case O_ONCE:
+        if (date > start_date_ && date <= end_date_)
+          addSource(sources, Source::S_OPERATION, event, operation.value_,
+                    Schedule(Schedule::R_DAYS, 1, date, date, date));
+        continue;
+      case O_MONTHLY:
+        step = 1;
+        break;
+      case O_BIMONTHLY:
+        step = 2;
+        break;
+      case O_QUARTERLY:
+        step = 3;
+        break;
+      case O_BIANNUALLY:
+        step = 6;
+        break;
+      case O_ANNUALLY:
+        rule = Schedule::R_MONTHS_OVERCAP;
+        step = 12;
+        break;
 
-void Deposit::insertReplenishList() {
-  for (size_t i = 0; i < replenish_list_.size(); ++i) {
-    insertOperation(replenish_list_.cbegin() + i, E_REPLENISH);
+      default:
+        continue;
+    }
+    addSource(sources, Source::S_OPERATION, event, operation.value_,
+              Schedule(rule, step, date, start_date_ + 1, end_date_));
   }
 }
 
-void Deposit::insertWithdrawalList() {
-  for (size_t i = 0; i < withdrawal_list_.size(); ++i) {
-    insertOperation(withdrawal_list_.cbegin() + i, E_WITHDRAWAL);
-  }
+void Deposit::addPaydaySource(std::vector<Source>& sources) const {
+  Schedule::Rule rule = Schedule::R_DAYS;
+  int step = 0;
+  if (paydayRule(rule, step) == false) return;
+  addSource(sources, Source::S_PAYDAY, E_PAYDAY, 0.0L,
+            Schedule(rule, step, start_date_, start_date_ + 1, end_date_ - 1));
 }
 
-void Deposit::insertPaydays() {
+/* Returns false if interest is paid only at the end of term. */
+bool Deposit::paydayRule(Schedule::Rule& rule, int& step) const noexcept {
+  rule = Schedule::R_MONTHS_OVERCAP;
   switch (periodicity_) {
     case P_DAILY:
-      pushPaydaysSkipDays(1);
+      rule = Schedule::R_DAYS;
+      step = 1;
       break;
     case P_WEEKLY:
-      pushPaydaysSkipDays(7);
+      rule = Schedule::R_DAYS;
+      step = 7;
       break;
     case P_MONTHLY:
-      pushPaydaysSkipMonths(1);
+      step = 1;
       break;
     case P_QUARTERLY:
-      pushPaydaysSkipMonths(3);
+      step = 3;
       break;
     case P_BIANNUALLY:
-      pushPaydaysSkipMonths(6);
+      step = 6;
       break;
     case P_ANNUALLY:
-      pushPaydaysSkipMonths(12);
+      step = 12;
       break;
 
     default:
-      break;
-  }
-}
-
-void Deposit::insertLastPayday() { pushEvent(E_PAYDAY, end_date_); }
-
-/* Dates of operations and payments seems to be produced in unstable manner
- * date-wise on calcus.ru when day is 29-31. The method is chosen depends on
- * calcul.ru behaviour with different periodicity of operation (2 methods to
- * skip months). */
-void Deposit::insertOperation(std::vector<Operation>::const_iterator element,
-                              EventType event) {
-  Date date = element->date_;
-  switch (element->period_) {
-    case O_ONCE:
-      if (date > start_date_ && date <= end_date_)
-        pushEvent(event, date, element->value_);
-      break;
-    case O_MONTHLY:
-      pushOperationsShiftMonths(event, date, element->value_, 1);
-      break;
-    case O_BIMONTHLY:
-      pushOperationsShiftMonths(event, date, element->value_, 2);
-      break;
-    case O_QUARTERLY:
-      pushOperationsShiftMonths(event, date, element->value_, 3);
-      break;
-    case O_BIANNUALLY:
-      pushOperationsShiftMonths(event, date, element->value_, 6);
-      break;
-    case O_ANNUALLY:
-      pushOperationsShiftMonthsWithOvercap(event, date, element->value_, 12);
-      break;
-
-    default:
-      break;
-  }
-}
-
-/* Build dates relatively to start date, cut days if needed.
-Example: 31.01.2024 + 1 month = 29.02.2024, 31.03.2024, 30.04.2024, etc. */
-void Deposit::pushOperationsShiftMonths(EventType event, Date date,
-                                        long double value, size_t step) {
-  Date start = date;
-  for (size_t j = step; date <= end_date_; j += step) {
-    if (date > start_date_) pushEvent(event, date, value);
-    date = start.shiftMonths(j);
-  }
-}
-
-/* Build dates relatively to current date with possibility of overcapping by
-1-3 days. Current date value is always reassigned. Example: 29.02.2024 + 12
-months = 01.03.2025, ... , 01.03.2028, etc. */
-void Deposit::pushOperationsShiftMonthsWithOvercap(EventType event, Date date,
-                                                   long double value,
-                                                   size_t step) {
-  while (date <= end_date_) {
-    if (date > start_date_) pushEvent(event, date, value);
-    date = nextMonthDate(date, step);
-  }
-}
-
-void Deposit::pushPaydaysSkipMonths(int step) {
-  Date current = nextMonthDate(start_date_, step);
-  for (; current < end_date_; current = nextMonthDate(current, step)) {
-    pushEvent(E_PAYDAY, current);
+      return false;
   }
+  return true;
 }
 
-void Deposit::pushPaydaysSkipDays(int step) {
-  Date current = start_date_ + step;
-  for (; current < end_date_; current += step) {
-    pushEvent(E_PAYDAY, current);
+void Deposit::addSource(std::vector<Source>& sources, Source::Kind kind,
+                        EventType event, long double value,
+                        const Schedule& schedule) const {
+  Source source;
+  source.next = schedule.begin();
+  source.end = schedule.end();
+  source.date = start_date_;
+  source.value = value;
+  source.event = event;
+  source.kind = kind;
+  sources.push_back(source);
+}
+
+/* Operation moved out of deposit term keeps its own date. Paydays moved to
+ * the end of term or onto previous payday are dropped, the next payday takes
+ * their interest. Calendar moves dates monotonically, so sources stay
+ * sorted. */
+bool Deposit::advanceSource(Source& source) const {
+  while (source.next != source.end) {
+    Date date = *source.next++;
+    if (source.kind != Source::S_FIXED) {
+      Date moved = calendar_.adjust(date, adjustment_);
+      if (source.kind == Source::S_OPERATION) {
+        if (moved > start_date_ && moved <= end_date_) date = moved;
+      } else if (moved > source.date && moved < end_date_) {
+        date = moved;
+      } else {
+        continue;
+      }
+    }
+    source.date = date;
+    return true;
   }
-}
-
-void Deposit::pushEvent(EventType event, Date date, long double change) {
-  if (event == E_WITHDRAWAL) change = -change;
-  event_list_.push_back(Event(event, date, 0.0L, change, 0.0L, 0.0L));
+  return false;
 }
 
 bool Deposit::validateSettings() const noexcept {
@@ -422,25 +535,6 @@ bool Deposit::checkDates() const noexcept {
          start_date_.getYear() <= MAX_START_YEAR;
 }
 
-Date Deposit::nextMonthDate(const Date& date, int n) {
-  Date ret = date;
-  int days = date.getDay();
-  if (date.getDay() >= 29) {
-    ret.addMonths(n);
-    if (!Date::isDateValid(date.getDay(), ret.getMonth(), ret.getYear())) {
-      ret.setDate(1, ret.getMonth(), ret.getYear());
-      ret += days - 1;
-      return ret;
-    } else {
-      ret.setDate(date.getDay(), ret.getMonth(), ret.getYear());
-      return ret;
-    }
-  } else { /* if (date.getDay() < 29) */
-    ret.addMonths(n);
-    return ret;
-  }
-}
-
 long double Deposit::calculateDayValue(int year, long double rate) noexcept {
   if (isLeapYear(year) == false) {
     return rate / 365.0L;
@@ -456,11 +550,4 @@ bool Deposit::isLeapYear(int year) noexcept {
   return false;
 }
 
-bool Deposit::dateComparator(const Event& first, const Event& second) noexcept {
-  if (first.date_ == second.date_) {
-    return first.event_ < second.event_;
-  }
-  return first.date_ < second.date_;
-}
-
 }  // namespace s21
@@ -2,6 +2,7 @@
 #define S21_DEPOSIT_H
 
 #include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #include "s21_common.h"
@@ -32,11 +33,22 @@ class Deposit {
   };
 
   /* WARNING: the order of enum is essential and is used to compare Event
-   * objects. */
-  enum EventType { E_REPLENISH, E_WITHDRAWAL, E_DECLINE, E_PAYDAY, E_NEWYEAR };
+   * objects. One byte, so it packs into Event after date. */
+  enum EventType : unsigned char {
+    E_REPLENISH,
+    E_WITHDRAWAL,
+    E_DECLINE,
+    E_PAYDAY,
+    E_NEWYEAR
+  };
 
   enum TermType { T_DAY, T_MONTH, T_YEAR };
 
+  /* M_SUMMARY_ONLY computes balance, totals and tax list only, event list
+   * is left empty and events are not stored at all. Its values may differ
+   * from M_FULL ones by rounding. */
+  enum Mode { M_FULL, M_SUMMARY_ONLY };
+
   struct Operation {
    private:
     OperPeriod period_;
@@ -55,27 +67,29 @@ class Deposit {
     long double value() const noexcept { return value_; }
   };
 
+  /* Values are stored as doubles, they are only results of one step, which
+   * is counted in long double as running totals are. Deposit of many years
+   * has hundreds of thousands of events, so they are packed into 40 bytes. */
   struct Event {
    private:
-    EventType event_;
+    double gain_;
+    double balance_change_;
+    double payment_;
+    double balance_;
     Date date_;
-    long double gain_;
-    long double balance_change_;
-    long double payment_;
-    long double balance_;
+    EventType event_;
 
    public:
     Event() = default;
     ~Event() = default;
-    Event(EventType event, Date date, long double gain,
-          long double balance_change, long double payment,
-          long double balance) noexcept
-        : event_(event),
-          date_(date),
-          gain_(gain),
+    Event(EventType event, Date date, double gain, double balance_change,
+          double payment, double balance) noexcept
+        : gain_(gain),
           balance_change_(balance_change),
           payment_(payment),
-          balance_(balance) {}
+          balance_(balance),
+          date_(date),
+          event_(event) {}
     friend class Deposit;
 
     EventType event() const noexcept { return event_; }
@@ -124,11 +138,16 @@ class Deposit {
   void popBackWithdrawal() noexcept;
   void clearReplenish() noexcept;
   void clearWithdrawal() noexcept;
+  /* Paydays and operations that fall on non-business days are moved by
+   * calendar. A_NONE keeps dates as they are. */
+  void setCalendar(const Calendar& calendar,
+                   Calendar::Adjustment adjustment);
 
   /* Methods to look at some user variables. No bound checking. */
   bool isCapitalization() const noexcept;
   double getDeposit() const noexcept;
   double getRemainderLimit() const noexcept;
+  Calendar::Adjustment getAdjustment() const noexcept;
   size_t getReplenishListSize() const noexcept;
   size_t getWithdrawalListSize() const noexcept;
   std::vector<Operation>::const_iterator getReplenishListElement(
@@ -137,7 +156,7 @@ class Deposit {
       size_t index) const noexcept;
 
   /* Main method to run. Provides bound checking. */
-  bool calculate();
+  bool calculate(Mode mode = M_FULL);
 
   /* Methods to retrieve result content. */
   size_t getEventListSize() const noexcept;
@@ -179,11 +198,21 @@ class Deposit {
   /* END: Variables with bound checking. */
   bool capital_ = false;
   PayPeriod periodicity_ = P_AT_END;
+  Calendar calendar_{};
+  Calendar::Adjustment adjustment_ = Calendar::A_NONE;
 
   /* Operational variables */
   Date end_date_;
   long double year_income_ = 0.0L;
   long double day_value_ = 0.0L;
+  /* Date of the previous event, gains of events since the last payday and
+   * number of events counted. M_FULL keeps pending gains one by one and
+   * adds them to payday from the latest, as event list always did, so its
+   * results do not change. M_SUMMARY_ONLY sums them as they come. */
+  Date last_date_{1, 1, 1900};
+  std::vector<long double> pending_gains_{};
+  long double pending_gain_ = 0.0L;
+  size_t event_count_ = 0;
 
   /* Result values */
   long double balance_ = 0.0L;
@@ -194,46 +223,68 @@ class Deposit {
   std::vector<Event> event_list_{};
   std::vector<Tax> tax_list_{};
 
+  /* Event being counted. Its values are computed and added to totals in
+   * long double, Event gets narrowed copies when it is stored. */
+  struct Step {
+    EventType event = E_REPLENISH;
+    Date date{1, 1, 1900};
+    long double gain = 0.0L;
+    long double balance_change = 0.0L;
+    long double payment = 0.0L;
+    long double balance = 0.0L;
+  };
+
+  /* Sorted dates of one kind of events, see mergeEvents(). Payday source
+   * keeps the last payday in 'date' to drop paydays moved onto it. */
+  struct Source {
+    enum Kind { S_FIXED, S_OPERATION, S_PAYDAY };
+    Schedule::Iterator next;
+    Schedule::Iterator end;
+    Date date{1, 1, 1900};
+    long double value;
+    EventType event;
+    Kind kind;
+  };
+
   /* Misc methods */
   void setDefaultValues() noexcept;
   void calculateEndDate();
-  void calculateValues();
-  void countReplenish(std::vector<Event>::iterator i) noexcept;
-  void countWithdrawal(std::vector<Event>::iterator i) noexcept;
-  void countNewyear(std::vector<Event>::iterator i);
-  void countPayday(std::vector<Event>::iterator i);
-  void countBalance(std::vector<Event>::iterator i) noexcept;
-  void countGain(std::vector<Event>::iterator i) noexcept;
-  void sumPreviousGains(std::vector<Event>::iterator i) noexcept;
-  void countTax(std::vector<Event>::iterator i);
+  void calculateEvents(Mode mode);
+  void countEvent(Step& step, Mode mode);
+  void countReplenish(Step& step) noexcept;
+  void countWithdrawal(Step& step) noexcept;
+  void countNewyear(Step& step);
+  void countPayday(Step& step, Mode mode);
+  void countBalance(Step& step) noexcept;
+  void countGain(Step& step) noexcept;
+  void countTax(int year);
   void countDayValue(int year) noexcept;
-  void fixEventList(bool splice_on) noexcept;
-  void spliceOperations(size_t first, size_t second) noexcept;
-  void insertDeposit();
-  void insertNewYears();
-  void insertReplenishList();
-  void insertWithdrawalList();
-  void insertPaydays();
-  void insertLastPayday();
-  void insertOperation(std::vector<Operation>::const_iterator element,
-                       EventType event);
-  void pushOperationsShiftMonths(EventType event, Date date, long double value,
-                                 size_t step);
-  void pushOperationsShiftMonthsWithOvercap(EventType event, Date date,
-                                            long double value, size_t step);
-  void pushPaydaysSkipMonths(int step);
-  void pushPaydaysSkipDays(int step);
-  void pushEvent(EventType event, Date date, long double change = 0.0L);
+  void calculateSummary();
+  bool paydayRule(Schedule::Rule& rule, int& step) const noexcept;
+  template <class Emit>
+  void mergeEvents(Emit emit) const;
+  void addOperationSources(std::vector<Source>& sources,
+                           const std::vector<Operation>& list,
+                           EventType event) const;
+  void addPaydaySource(std::vector<Source>& sources) const;
+  void addSource(std::vector<Source>& sources, Source::Kind kind,
+                 EventType event, long double value,
+                 const Schedule& schedule) const;
+  bool advanceSource(Source& source) const;
   bool validateSettings() const noexcept;
   bool checkReplenishes() const noexcept;
   bool checkWithdrawals() const noexcept;
   bool checkPositiveDouble(double value) const noexcept;
   bool checkDates() const noexcept;
-  static Date nextMonthDate(const Date& date, int n);
   static long double calculateDayValue(int year, long double rate) noexcept;
   static bool isLeapYear(int year) noexcept;
-  static bool dateComparator(const Event& first, const Event& second) noexcept;
 };
+
+static_assert(sizeof(Deposit::Event) <= 40,
+              "Event must stay packed: four values, date and type");
+static_assert(std::is_trivially_copyable<Deposit::Event>::value,
+              "Event must be trivially copyable");
+
 }  // namespace s21
 
 #endif  // S21_DEPOSIT_H
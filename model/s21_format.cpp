@@ -0,0 +1,110 @@
+#include "s21_format.h"
+
+#include <algorithm>
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace s21 {
+
+#ifndef __cpp_lib_to_chars
+namespace {
+
+/* printf into buffer of Format::BUFFER_SIZE with '.' as decimal point. */
+char* Print(char* first, const char* format, int precision,
+            double value) noexcept {
+  int size =
+      std::snprintf(first, Format::BUFFER_SIZE, format, precision, value);
+  char* last = first + std::min<size_t>(std::max(size, 0),
+                                        Format::BUFFER_SIZE - 1);
+  char point = *std::localeconv()->decimal_point;
+  if (point != '.') std::replace(first, last, point, '.');
+  return last;
+}
+
+}  // namespace
+#endif
+
+/* std::to_chars prints the shortest representation by Ryu algorithm and
+ * exact rounding for given precision, both without locale and allocation.
+ * Standard libraries without it for double, e.g. libc++ of older macOS
+ * toolchains, use snprintf: the shortest form is the least precision that
+ * reads back to the same value, written in fixed or exponent form, whichever
+ * is shorter, as std::to_chars chooses. */
+char* Format::Shortest(char* first, double value) noexcept {
+  if (std::isfinite(value) == false) return Special(first, value);
+#ifdef __cpp_lib_to_chars
+  return std::to_chars(first, first + BUFFER_SIZE, value).ptr;
+#else
+  int precision = 1;
+  char* last = Print(first, "%.*e", precision - 1, value);
+  while (precision < 17 && std::strtod(first, nullptr) != value)
+    last = Print(first, "%.*e", ++precision - 1, value);
+  int exponent = std::atoi(std::strchr(first, 'e') + 1);
+  char fixed[BUFFER_SIZE];
+  char* fixed_last =
+      Print(fixed, "%.*f", std::max(0, precision - 1 - exponent), value);
+  if (fixed_last - fixed > last - first ||
+      fixed_last - fixed == static_cast<ptrdiff_t>(BUFFER_SIZE) - 1)
+    return last;
+  std::memcpy(first, fixed, fixed_last - fixed);
+  return first + (fixed_last - fixed);
+#endif
+}
+
+char* Format::Precise(char* first, double value, int precision) noexcept {
+  if (std::isfinite(value) == false) return Special(first, value);
+  precision = std::clamp(precision, 1, MAX_PRECISION);
+#ifdef __cpp_lib_to_chars
+  return std::to_chars(first, first + BUFFER_SIZE, value,
+                       std::chars_format::general, precision)
+      .ptr;
+#else
+  return Print(first, "%.*g", precision, value);
+#endif
+}
+
+char* Format::Money(char* first, double value, bool trim) noexcept {
+  if (std::isfinite(value) == false || std::fabs(value) >= 1e17)
+    return Precise(first, value);
+#ifdef __cpp_lib_to_chars
+  char* last =
+      std::to_chars(first, first + BUFFER_SIZE, value,
+                    std::chars_format::fixed, 2)
+          .ptr;
+#else
+  char* last = Print(first, "%.*f", 2, value);
+#endif
+  if (*first == '-' && IsZero(first + 1, last) == true) {
+    std::memmove(first, first + 1, last - first - 1);
+    last--;
+  }
+  if (trim == true) {
+    while (last[-1] == '0') last--;
+    if (last[-1] == '.') last--;
+  }
+  return last;
+}
+
+std::string Format::ToString(double value, int precision) {
+  char buffer[BUFFER_SIZE];
+  return std::string(buffer, Precise(buffer, value, precision));
+}
+
+bool Format::IsZero(const char* first, const char* last) noexcept {
+  for (; first < last; ++first)
+    if (*first != '0' && *first != '.') return false;
+  return true;
+}
+
+char* Format::Special(char* first, double value) noexcept {
+  const char* text = std::isnan(value) ? "nan" : value > 0 ? "inf" : "-inf";
+  size_t size = std::strlen(text);
+  std::memcpy(first, text, size);
+  return first + size;
+}
+
+}  // namespace s21
@@ -0,0 +1,42 @@
+#ifndef S21_FORMAT_H
+#define S21_FORMAT_H
+
+#include <cstddef>
+#include <string>
+
+namespace s21 {
+
+/* Formatting of doubles into caller's buffer of at least BUFFER_SIZE chars,
+ * without allocations. Functions return pointer past the last written char,
+ * terminating zero is not written. Decimal point is always '.', NaN is
+ * written as "nan" and infinities as "inf" and "-inf". */
+class Format {
+ public:
+  static constexpr size_t BUFFER_SIZE = 32;
+  /* Significant digits that read back to the same double, the most Precise
+   * writes. */
+  static constexpr int MAX_PRECISION = 17;
+
+  /* The shortest form that reads back to the same double. */
+  static char* Shortest(char* first, double value) noexcept;
+  /* Rounded to 'precision' significant digits, without trailing zeros, in
+   * exponent form if exponent is below -4 or not below precision, like
+   * printf "%.16g". Precision is clamped to 1..MAX_PRECISION, so number
+   * always fits into buffer. */
+  static char* Precise(char* first, double value, int precision = 16) noexcept;
+  /* Two decimals, e.g. "1234.50". With 'trim' zeros at the end of fraction
+   * are removed with the point, e.g. "1234.5". Value rounded to zero is
+   * written without sign. Values of 1e17 and above are written by
+   * Precise. */
+  static char* Money(char* first, double value, bool trim = false) noexcept;
+
+  static std::string ToString(double value, int precision = 16);
+
+ private:
+  static char* Special(char* first, double value) noexcept;
+  static bool IsZero(const char* first, const char* last) noexcept;
+};
+
+}  // namespace s21
+
+#endif  // S21_FORMAT_H
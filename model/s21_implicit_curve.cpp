@@ -0,0 +1,171 @@
+#include "s21_implicit_curve.h"
+
+#include <atomic>
+#include <cmath>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+namespace {
+
+/* Points passed to evaluator in one call. */
+constexpr size_t CHUNK_SIZE = 1024;
+
+}  // namespace
+
+ImplicitCurve::ImplicitCurve(const Options& options) : options_(options) {}
+
+bool ImplicitCurve::Trace(const Evaluator& evaluate, double min_x,
+                          double max_x, double min_y, double max_y,
+                          std::vector<Segment>& segments) const {
+  segments.clear();
+  if (options_.cells_x <= 0 || options_.cells_y <= 0 || !(max_x > min_x) ||
+      !(max_y > min_y))
+    return true;
+  int nx = options_.cells_x + 1, ny = options_.cells_y + 1;
+  double width = (max_x - min_x) / options_.cells_x;
+  double height = (max_y - min_y) / options_.cells_y;
+  std::vector<double> x(nx * ny), y(nx * ny), z;
+  for (int j = 0; j < ny; ++j) {
+    for (int i = 0; i < nx; ++i) {
+      x[j * nx + i] = min_x + i * width;
+      y[j * nx + i] = min_y + j * height;
+    }
+  }
+  if (Evaluate(evaluate, x, y, z) == false) return false;
+
+  std::vector<Cell> cells;
+  for (int j = 0; j + 1 < ny; ++j) {
+    for (int i = 0; i + 1 < nx; ++i) {
+      Cell cell{min_x + i * width,
+                min_y + j * height,
+                width,
+                height,
+                {z[j * nx + i], z[j * nx + i + 1], z[(j + 1) * nx + i + 1],
+                 z[(j + 1) * nx + i]}};
+      if (HasSignChange(cell) == true) cells.push_back(cell);
+    }
+  }
+  for (int depth = 0; depth < options_.max_depth; ++depth)
+    if (Subdivide(evaluate, cells) == false) return false;
+  for (const Cell& cell : cells) March(cell, segments);
+  return true;
+}
+
+std::string ImplicitCurve::ToZeroForm(const std::string& equation) {
+  size_t position = equation.find('=');
+  if (position == std::string::npos) return equation;
+  return "(" + equation.substr(0, position) + ")-(" +
+         equation.substr(position + 1) + ")";
+}
+
+/* Points are passed to evaluator by chunks, chunks are spread over threads. */
+bool ImplicitCurve::Evaluate(const Evaluator& evaluate,
+                             const std::vector<double>& x,
+                             const std::vector<double>& y,
+                             std::vector<double>& z) const {
+  z.assign(x.size(), NAN);
+  std::atomic<bool> stopped{false};
+  size_t chunks = (x.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  ParallelFor(
+      chunks,
+      [&](size_t chunk) {
+        if (stopped.load(std::memory_order_relaxed) == true) return;
+        size_t offset = chunk * CHUNK_SIZE;
+        size_t count = std::min(CHUNK_SIZE, x.size() - offset);
+        if (evaluate(x.data() + offset, y.data() + offset, z.data() + offset,
+                     count) == false)
+          stopped.store(true, std::memory_order_relaxed);
+      },
+      options_.threads);
+  return stopped.load() == false;
+}
+
+/* Split every cell into four by its center and middles of its edges, keep
+ * only parts with sign change. */
+bool ImplicitCurve::Subdivide(const Evaluator& evaluate,
+                              std::vector<Cell>& cells) const {
+  std::vector<double> x, y, z;
+  x.reserve(cells.size() * 5);
+  y.reserve(cells.size() * 5);
+  for (const Cell& cell : cells) {
+    double half_w = cell.width / 2, half_h = cell.height / 2;
+    const double points[5][2] = {{cell.x + half_w, cell.y},
+                                 {cell.x + cell.width, cell.y + half_h},
+                                 {cell.x + half_w, cell.y + cell.height},
+                                 {cell.x, cell.y + half_h},
+                                 {cell.x + half_w, cell.y + half_h}};
+    for (const auto& point : points) {
+      x.push_back(point[0]);
+      y.push_back(point[1]);
+    }
+  }
+  if (Evaluate(evaluate, x, y, z) == false) return false;
+
+  std::vector<Cell> parts;
+  for (size_t k = 0; k < cells.size(); ++k) {
+    const Cell& cell = cells[k];
+    const double* v = cell.values;
+    double bottom = z[k * 5], right = z[k * 5 + 1], top = z[k * 5 + 2],
+           left = z[k * 5 + 3], center = z[k * 5 + 4];
+    double w = cell.width / 2, h = cell.height / 2;
+    const Cell quarters[4] = {
+        {cell.x, cell.y, w, h, {v[0], bottom, center, left}},
+        {cell.x + w, cell.y, w, h, {bottom, v[1], right, center}},
+        {cell.x + w, cell.y + h, w, h, {center, right, v[2], top}},
+        {cell.x, cell.y + h, w, h, {left, center, top, v[3]}}};
+    for (const Cell& quarter : quarters)
+      if (HasSignChange(quarter) == true) parts.push_back(quarter);
+  }
+  cells.swap(parts);
+  return true;
+}
+
+/* Zero is counted as positive. Cells with undefined corners are skipped. */
+bool ImplicitCurve::HasSignChange(const Cell& cell) noexcept {
+  int positive = 0;
+  for (double value : cell.values) {
+    if (std::isfinite(value) == false) return false;
+    if (value >= 0) positive++;
+  }
+  return positive > 0 && positive < 4;
+}
+
+/* Edge k joins corners k and k + 1. Contour crosses edges whose corners have
+ * different signs, at linearly interpolated point. When all four edges are
+ * crossed, mean of corners decides which corners are cut off. */
+void ImplicitCurve::March(const Cell& cell, std::vector<Segment>& segments) {
+  const double corners[4][2] = {{cell.x, cell.y},
+                                {cell.x + cell.width, cell.y},
+                                {cell.x + cell.width, cell.y + cell.height},
+                                {cell.x, cell.y + cell.height}};
+  const double* v = cell.values;
+  bool sign[4];
+  for (int k = 0; k < 4; ++k) sign[k] = v[k] >= 0;
+  double cross[4][2];
+  int crossed[4];
+  int count = 0;
+  for (int k = 0; k < 4; ++k) {
+    int next = (k + 1) % 4;
+    if (sign[k] == sign[next]) continue;
+    double t = v[k] / (v[k] - v[next]);
+    cross[k][0] = corners[k][0] + t * (corners[next][0] - corners[k][0]);
+    cross[k][1] = corners[k][1] + t * (corners[next][1] - corners[k][1]);
+    crossed[count++] = k;
+  }
+  if (count == 2) {
+    segments.push_back(Segment{cross[crossed[0]][0], cross[crossed[0]][1],
+                               cross[crossed[1]][0], cross[crossed[1]][1]});
+  } else if (count == 4) {
+    bool center = (v[0] + v[1] + v[2] + v[3]) / 4 >= 0;
+    for (int k = 0; k < 4; ++k) {
+      if (sign[k] == center) continue;
+      int previous = (k + 3) % 4;
+      segments.push_back(Segment{cross[previous][0], cross[previous][1],
+                                 cross[k][0], cross[k][1]});
+    }
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,70 @@
+#ifndef S21_IMPLICIT_CURVE_H
+#define S21_IMPLICIT_CURVE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/* Zero contour of f(x, y) by marching squares. f is evaluated on coarse grid
+ * first, then only cells where f changes sign are split into four, down to
+ * max_depth levels. Points of every step are evaluated in parallel. Curve
+ * parts that lie completely inside one coarse cell without sign change in
+ * its corners are not found. */
+class ImplicitCurve {
+ public:
+  struct Segment {
+    double x1;
+    double y1;
+    double x2;
+    double y2;
+  };
+
+  struct Options {
+    int cells_x = 64;
+    int cells_y = 64;
+    int max_depth = 4;
+    unsigned threads = 0;
+  };
+
+  /* Evaluate 'count' points (x[i], y[i]) into z. Called from several threads
+   * at once. Returning false stops tracing, e.g. when request is cancelled. */
+  typedef std::function<bool(const double* x, const double* y, double* z,
+                             size_t count)>
+      Evaluator;
+
+  ImplicitCurve() = default;
+  explicit ImplicitCurve(const Options& options);
+  ~ImplicitCurve() = default;
+
+  /* Returns false if tracing was stopped by evaluator. */
+  bool Trace(const Evaluator& evaluate, double min_x, double max_x,
+             double min_y, double max_y, std::vector<Segment>& segments) const;
+  /* Bring equation "a = b" to expression "(a)-(b)", which is zero on the
+   * curve. Expression without '=' is returned as is. */
+  static std::string ToZeroForm(const std::string& equation);
+
+ private:
+  /* Corner values go counterclockwise from (x, y). */
+  struct Cell {
+    double x;
+    double y;
+    double width;
+    double height;
+    double values[4];
+  };
+
+  Options options_{};
+
+  bool Evaluate(const Evaluator& evaluate, const std::vector<double>& x,
+                const std::vector<double>& y, std::vector<double>& z) const;
+  bool Subdivide(const Evaluator& evaluate, std::vector<Cell>& cells) const;
+  static bool HasSignChange(const Cell& cell) noexcept;
+  static void March(const Cell& cell, std::vector<Segment>& segments);
+};
+
+}  // namespace s21
+
+#endif  // S21_IMPLICIT_CURVE_H
@@ -0,0 +1,156 @@
+#include "s21_integration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+namespace {
+
+/* Kronrod nodes in descending order on [-1, 1], the last one is the middle.
+ * Nodes with odd indexes are also nodes of Gauss rule. */
+constexpr double KRONROD_NODES[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.0};
+constexpr double KRONROD_WEIGHTS[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+constexpr double GAUSS_WEIGHTS[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+}  // namespace
+
+Integration::Integration(const Options& options) : options_(options) {}
+
+/* Segments are split until error of each one is below its share of required
+ * error, proportional to its width. Required error is taken from the initial
+ * estimate, so no segment waits for others. Accepted segments are summed in
+ * order of position, so result does not depend on number of threads. Once
+ * integration is stopped, queued segments are dropped without evaluation. */
+bool Integration::Integrate(const Calculation& calculation, double a, double b,
+                            Result& result, const Proceed& proceed) const {
+  result = Result();
+  if (calculation.GetResults(nullptr, nullptr, 0) == false) return false;
+  std::atomic<bool> stopped{false};
+  auto stop = [&proceed, &stopped]() {
+    if (stopped.load(std::memory_order_relaxed) == false && proceed &&
+        proceed() == false)
+      stopped.store(true, std::memory_order_relaxed);
+    return stopped.load(std::memory_order_relaxed);
+  };
+  if (a == b) {
+    result.value = result.error = 0.0;
+    result.converged = true;
+    return true;
+  }
+  unsigned threads = options_.threads ? options_.threads : HardwareThreads();
+  size_t count = options_.initial_segments ? options_.initial_segments
+                                          : static_cast<size_t>(threads) * 4;
+  std::vector<Segment> initial(count);
+  for (size_t i = 0; i < count; ++i) {
+    initial[i].a = i == 0 ? a : a + (b - a) * i / count;
+    initial[i].b = i + 1 == count ? b : a + (b - a) * (i + 1) / count;
+  }
+  ParallelFor(
+      count,
+      [&](size_t i) {
+        if (stop() == false) Evaluate(calculation, &initial[i], 1);
+      },
+      threads);
+  if (stopped.load() == true) return false;
+  double estimate = 0.0;
+  for (const Segment& segment : initial) estimate += segment.value;
+  double tolerance = std::max(options_.abs_tolerance,
+                              options_.rel_tolerance * std::fabs(estimate));
+  if (std::isfinite(estimate) == false) tolerance = INFINITY;
+  double width = std::fabs(b - a);
+
+  std::vector<std::vector<Segment>> accepted(threads);
+  std::atomic<size_t> segments{count};
+  std::atomic<bool> converged{true};
+  ParallelTasks(
+      initial,
+      [&](const Segment& segment, auto& spawn, unsigned thread) {
+        if (stop() == true) return;
+        double share = tolerance * std::fabs(segment.b - segment.a) / width;
+        double middle = (segment.a + segment.b) / 2;
+        if (segment.error <= share || std::isfinite(segment.value) == false) {
+          accepted[thread].push_back(segment);
+          return;
+        }
+        if (segment.depth >= options_.max_depth || middle == segment.a ||
+            middle == segment.b ||
+            segments.fetch_add(2) + 2 > options_.max_segments) {
+          converged = false;
+          accepted[thread].push_back(segment);
+          return;
+        }
+        Segment halves[2];
+        halves[0].a = segment.a;
+        halves[0].b = halves[1].a = middle;
+        halves[1].b = segment.b;
+        halves[0].depth = halves[1].depth = segment.depth + 1;
+        Evaluate(calculation, halves, 2);
+        spawn(halves[1]);
+        spawn(halves[0]);
+      },
+      threads);
+  if (stopped.load() == true) return false;
+
+  std::vector<Segment> all;
+  for (const std::vector<Segment>& part : accepted)
+    all.insert(all.end(), part.begin(), part.end());
+  std::sort(all.begin(), all.end(),
+            [a, b](const Segment& left, const Segment& right) {
+              return a < b ? left.a < right.a : left.a > right.a;
+            });
+  result.value = result.error = 0.0;
+  for (const Segment& segment : all) {
+    result.value += segment.value;
+    result.error += segment.error;
+  }
+  result.segments = std::min(segments.load(), options_.max_segments);
+  result.converged = converged && std::isfinite(result.value);
+  return true;
+}
+
+/* Evaluate rule on one segment or both halves of split one, all points are
+ * calculated as one block. */
+void Integration::Evaluate(const Calculation& calculation, Segment* segments,
+                           size_t count) {
+  double nodes[2 * NODES] = {}, values[2 * NODES];
+  for (size_t s = 0; s < count; ++s) {
+    double center = (segments[s].a + segments[s].b) / 2;
+    double half = (segments[s].b - segments[s].a) / 2;
+    double* point = nodes + s * NODES;
+    for (size_t j = 0; j < 7; ++j) {
+      point[j] = center - half * KRONROD_NODES[j];
+      point[NODES - 1 - j] = center + half * KRONROD_NODES[j];
+    }
+    point[7] = center;
+  }
+  calculation.GetResults(nodes, values, count * NODES);
+  for (size_t s = 0; s < count; ++s) {
+    const double* f = values + s * NODES;
+    double kronrod = KRONROD_WEIGHTS[7] * f[7];
+    double gauss = GAUSS_WEIGHTS[3] * f[7];
+    for (size_t j = 0; j < 7; ++j) {
+      double pair = f[j] + f[NODES - 1 - j];
+      kronrod += KRONROD_WEIGHTS[j] * pair;
+      if (j % 2 == 1) gauss += GAUSS_WEIGHTS[j / 2] * pair;
+    }
+    double half = (segments[s].b - segments[s].a) / 2;
+    segments[s].value = kronrod * half;
+    segments[s].error = std::fabs((kronrod - gauss) * half);
+  }
+}
+
+}  // namespace s21
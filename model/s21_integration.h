@@ -0,0 +1,73 @@
+#ifndef S21_INTEGRATION_H
+#define S21_INTEGRATION_H
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+
+#include "s21_calculation.h"
+
+namespace s21 {
+
+/* Definite integral of expression over [a, b] by adaptive Gauss-Kronrod rule:
+ * 15 Kronrod nodes give the value, 7 Gauss nodes among them give the error
+ * estimate. Nodes of one segment are evaluated as one block. Segments whose
+ * error is above their share of tolerance are halved; halves are processed
+ * in parallel with work stealing, so segments near singularities do not keep
+ * other threads idle. */
+class Integration {
+ public:
+  struct Options {
+    /* Required total error is max(abs_tolerance, rel_tolerance * |value|). */
+    double abs_tolerance = 1e-10;
+    double rel_tolerance = 1e-10;
+    /* Number of equal segments to start with, 0 takes 4 per thread. */
+    size_t initial_segments = 0;
+    /* Segments of this depth or past this total count are not split. */
+    int max_depth = 48;
+    size_t max_segments = 100000;
+    unsigned threads = 0;
+  };
+
+  struct Result {
+    double value = NAN;
+    double error = NAN;
+    /* Number of segments evaluated, 15 points each. */
+    size_t segments = 0;
+    /* False if tolerance is not reached or integrand is not finite. */
+    bool converged = false;
+  };
+
+  /* Called from several threads at once before every block of segments.
+   * Returning false stops integration, e.g. when request is cancelled. */
+  typedef std::function<bool()> Proceed;
+
+  Integration() = default;
+  explicit Integration(const Options& options);
+
+  /* Expression must be compiled. Returns false if it is not compiled or
+   * invalid, or if integration was stopped. b may be less than a. */
+  bool Integrate(const Calculation& calculation, double a, double b,
+                 Result& result, const Proceed& proceed = nullptr) const;
+
+ private:
+  static constexpr size_t NODES = 15;
+
+  struct Segment {
+    double a = 0.0;
+    double b = 0.0;
+    double value = 0.0;
+    double error = 0.0;
+    int depth = 0;
+  };
+
+  Options options_{};
+
+  /* 'count' is 1 or 2. */
+  static void Evaluate(const Calculation& calculation, Segment* segments,
+                       size_t count);
+};
+
+}  // namespace s21
+
+#endif  // S21_INTEGRATION_H
@@ -0,0 +1,115 @@
+#ifndef S21_PARALLEL_H
+#define S21_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/* Number of threads used by parallel algorithms by default. */
+inline unsigned HardwareThreads() noexcept {
+  unsigned threads = std::thread::hardware_concurrency();
+  return threads == 0 ? 1 : threads;
+}
+
+/* Call body(i) for every i in [0, count) using up to 'threads' threads, the
+ * calling thread included. Indexes are taken one by one from shared counter,
+ * so threads that are done early take the rest of work. Body must be
+ * thread-safe and must not throw. */
+template <typename Body>
+void ParallelFor(size_t count, Body&& body, unsigned threads = 0) {
+  if (threads == 0) threads = HardwareThreads();
+  threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+  if (threads <= 1) {
+    for (size_t i = 0; i < count; ++i) body(i);
+    return;
+  }
+  std::atomic<size_t> next{0};
+  auto work = [&next, &body, count]() {
+    for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = next.fetch_add(1, std::memory_order_relaxed))
+      body(i);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work);
+  work();
+  for (std::thread& thread : pool) thread.join();
+}
+
+/* Process 'initial' tasks and all tasks they spawn using up to 'threads'
+ * threads, the calling thread included. body(task, spawn, thread) handles one
+ * task and may call spawn(task) to add new ones; 'thread' is index of the
+ * calling thread in [0, threads). Every thread has its own deque: it takes
+ * the newest task of its own, and when it is empty, steals the oldest task of
+ * another thread, which is usually the largest one. Returns when no task is
+ * left. Body must be thread-safe and must not throw. */
+template <typename Task, typename Body>
+void ParallelTasks(const std::vector<Task>& initial, Body&& body,
+                   unsigned threads = 0) {
+  if (threads == 0) threads = HardwareThreads();
+  if (threads <= 1) {
+    std::vector<Task> stack(initial.rbegin(), initial.rend());
+    auto spawn = [&stack](const Task& task) { stack.push_back(task); };
+    while (stack.empty() == false) {
+      Task task = std::move(stack.back());
+      stack.pop_back();
+      body(task, spawn, 0U);
+    }
+    return;
+  }
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+  std::vector<Queue> queues(threads);
+  for (size_t i = 0; i < initial.size(); ++i)
+    queues[i % threads].tasks.push_back(initial[i]);
+  /* Tasks that are queued or running. Spawned task is counted before its
+   * parent is done, so zero means that all work is finished. */
+  std::atomic<size_t> pending{initial.size()};
+  auto work = [&queues, &pending, &body, threads](unsigned self) {
+    auto spawn = [&queues, &pending, self](const Task& task) {
+      pending.fetch_add(1);
+      std::lock_guard<std::mutex> lock(queues[self].mutex);
+      queues[self].tasks.push_back(task);
+    };
+    Task task;
+    while (pending.load() > 0) {
+      bool found = false;
+      for (unsigned k = 0; k < threads && found == false; ++k) {
+        Queue& queue = queues[(self + k) % threads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty() == true) continue;
+        if (k == 0) {
+          task = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        } else {
+          task = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+        }
+        found = true;
+      }
+      if (found == false) {
+        std::this_thread::yield();
+        continue;
+      }
+      body(task, spawn, self);
+      pending.fetch_sub(1);
+    }
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work, t);
+  work(0);
+  for (std::thread& thread : pool) thread.join();
+}
+
+}  // namespace s21
+
+#endif  // S21_PARALLEL_H
@@ -0,0 +1,116 @@
+#include "s21_reduction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+bool Reduction::Reduce(const Calculation& calculation, double min_x,
+                       double max_x, unsigned long long samples,
+                       Result& result, unsigned threads) {
+  result = Result();
+  if (calculation.GetResults(nullptr, nullptr, 0) == false) return false;
+  if (samples == 0) return true;
+  if (threads == 0) threads = HardwareThreads();
+  double step = samples > 1 ? (max_x - min_x) / (samples - 1) : 0.0;
+  /* The last point is put exactly at max_x. */
+  auto position = [=](unsigned long long index) {
+    return samples > 1 && index + 1 == samples ? max_x : min_x + index * step;
+  };
+  unsigned long long parts = std::min<unsigned long long>(
+      threads * PARTS_PER_THREAD, (samples + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  std::vector<Partial> partials(parts);
+  ParallelFor(
+      parts,
+      [&](size_t part) {
+        unsigned long long begin = samples * part / parts;
+        unsigned long long end = samples * (part + 1) / parts;
+        std::vector<double> x(BLOCK_SIZE), y(BLOCK_SIZE);
+        Partial& partial = partials[part];
+        for (unsigned long long first = begin; first < end;
+             first += BLOCK_SIZE) {
+          size_t count =
+              static_cast<size_t>(std::min<unsigned long long>(
+                  BLOCK_SIZE, end - first));
+          for (size_t i = 0; i < count; ++i) x[i] = position(first + i);
+          calculation.GetResults(x.data(), y.data(), count);
+          for (size_t i = 0; i < count; ++i) partial.Add(y[i], first + i);
+        }
+      },
+      threads);
+
+  Partial total;
+  for (const Partial& partial : partials) total.Merge(partial);
+  result.count = total.count;
+  result.nan_count = total.nan_count;
+  result.sign_changes = total.sign_changes;
+  result.sum = total.sum + total.compensation;
+  if (total.count > 0) {
+    result.min = total.min;
+    result.max = total.max;
+    result.arg_min = position(total.arg_min);
+    result.arg_max = position(total.arg_max);
+    result.mean = result.sum / total.count;
+  }
+  return true;
+}
+
+void Reduction::Partial::Add(double value, unsigned long long index) noexcept {
+  if (std::isfinite(value) == false) {
+    nan_count++;
+    return;
+  }
+  if (count == 0 || value < min) {
+    min = value;
+    arg_min = index;
+  }
+  if (count == 0 || value > max) {
+    max = value;
+    arg_max = index;
+  }
+  count++;
+  AddToSum(sum, compensation, value);
+  int sign = (value > 0) - (value < 0);
+  if (sign == 0) return;
+  if (first_sign == 0) first_sign = sign;
+  if (last_sign != 0 && last_sign != sign) sign_changes++;
+  last_sign = sign;
+}
+
+/* 'next' goes right after this part, so equal extremes keep the first
+ * position and sign may change on the border of parts. */
+void Reduction::Partial::Merge(const Partial& next) noexcept {
+  nan_count += next.nan_count;
+  if (next.count == 0) return;
+  if (count == 0 || next.min < min) {
+    min = next.min;
+    arg_min = next.arg_min;
+  }
+  if (count == 0 || next.max > max) {
+    max = next.max;
+    arg_max = next.arg_max;
+  }
+  count += next.count;
+  AddToSum(sum, compensation, next.sum);
+  compensation += next.compensation;
+  sign_changes += next.sign_changes;
+  if (last_sign != 0 && next.first_sign != 0 && last_sign != next.first_sign)
+    sign_changes++;
+  if (first_sign == 0) first_sign = next.first_sign;
+  if (next.last_sign != 0) last_sign = next.last_sign;
+}
+
+void Reduction::AddToSum(double& sum, double& compensation,
+                         double value) noexcept {
+  double total = sum + value;
+  if (std::fabs(sum) >= std::fabs(value))
+    compensation += (sum - total) + value;
+  else
+    compensation += (value - total) + sum;
+  sum = total;
+}
+
+}  // namespace s21
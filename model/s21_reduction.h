@@ -0,0 +1,70 @@
+#ifndef S21_REDUCTION_H
+#define S21_REDUCTION_H
+
+#include <cstddef>
+
+#include "s21_calculation.h"
+
+namespace s21 {
+
+/* Reductions of expression over 'samples' evenly spaced points of
+ * [min_x, max_x], both ends included. Points are generated and evaluated by
+ * blocks, nothing is stored, so memory does not depend on number of samples.
+ * Range is split into parts processed in parallel, partial results of parts
+ * are merged in order. */
+class Reduction {
+ public:
+  static constexpr size_t BLOCK_SIZE = 4096;
+  /* Parts per thread, so threads that are done early take the rest. */
+  static constexpr size_t PARTS_PER_THREAD = 8;
+
+  struct Result {
+    /* Number of finite values. */
+    unsigned long long count = 0;
+    /* Number of NaN and infinite values, i.e. domain errors and poles. */
+    unsigned long long nan_count = 0;
+    /* Extremes and their first positions, NaN if there are no finite
+     * values. */
+    double min = NAN;
+    double max = NAN;
+    double arg_min = NAN;
+    double arg_max = NAN;
+    double sum = 0.0;
+    double mean = NAN;
+    /* Sign changes between neighbouring nonzero finite values, zeros and
+     * undefined values between them are skipped. */
+    unsigned long long sign_changes = 0;
+  };
+
+  /* Expression must be compiled. Returns false if it is not compiled or
+   * invalid. */
+  static bool Reduce(const Calculation& calculation, double min_x,
+                     double max_x, unsigned long long samples, Result& result,
+                     unsigned threads = 0);
+
+ private:
+  struct Partial {
+    unsigned long long count = 0;
+    unsigned long long nan_count = 0;
+    double min = NAN;
+    double max = NAN;
+    unsigned long long arg_min = 0;
+    unsigned long long arg_max = 0;
+    /* Compensated sum by Neumaier. */
+    double sum = 0.0;
+    double compensation = 0.0;
+    unsigned long long sign_changes = 0;
+    int first_sign = 0;
+    int last_sign = 0;
+
+    void Add(double value, unsigned long long index) noexcept;
+    void Merge(const Partial& next) noexcept;
+  };
+
+  static void AddToSum(double& sum, double& compensation,
+                       double value) noexcept;
+};
+
+}  // namespace s21
+
+#endif  // S21_REDUCTION_H
@@ -0,0 +1,61 @@
+#ifndef S21_RING_BUFFER_H
+#define S21_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+
+/* Lock-free bounded queue for exactly one producer thread and one consumer
+ * thread. Capacity must be a power of two. */
+template <typename T, size_t Capacity>
+class RingBuffer {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "RingBuffer capacity must be a power of two.");
+
+ public:
+  RingBuffer() = default;
+  ~RingBuffer() = default;
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  /* Producer side. Return false if buffer is full. */
+  bool push(const T& value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == Capacity) return false;
+    buffer_[head & MASK] = value;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /* Consumer side. Return false if buffer is empty. */
+  bool pop(T& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) return false;
+    value = buffer_[tail & MASK];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /* Exact only when called from producer or consumer with the other side
+   * idle. */
+  size_t size() const noexcept {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+  bool empty() const noexcept { return size() == 0; }
+  static constexpr size_t capacity() noexcept { return Capacity; }
+
+ private:
+  static constexpr size_t MASK = Capacity - 1;
+  /* Indexes grow infinitely and are masked on access. Head and tail are
+   * placed in separate cache lines to avoid false sharing. */
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+  std::vector<T> buffer_ = std::vector<T>(Capacity);
+};
+
+}  // namespace s21
+
+#endif  // S21_RING_BUFFER_H
@@ -0,0 +1,138 @@
+#include "s21_sample_cache.h"
+
+#include <climits>
+#include <cmath>
+
+namespace s21 {
+
+SampleCache::SampleCache(size_t max_tiles)
+    : max_tiles_(max_tiles > 0 ? max_tiles : 1) {}
+
+void SampleCache::SetFunction(const std::string& expression, bool degree) {
+  function_ = functions_.Select(expression, degree);
+}
+
+bool SampleCache::Find(int level, long long index, double& value) {
+  if (FindOnLevel(level, index, value) == true) return true;
+  for (int d = 1; d <= MAX_LEVEL_DISTANCE; ++d) {
+    long long scale = 1LL << d;
+    if (index % scale == 0 && FindOnLevel(level + d, index / scale, value))
+      return true;
+    if (index <= LLONG_MAX / scale && index >= LLONG_MIN / scale &&
+        FindOnLevel(level - d, index * scale, value))
+      return true;
+  }
+  return false;
+}
+
+void SampleCache::Store(int level, long long index, double value) {
+  long long tile_index = TileIndex(index);
+  TileKey key{function_, level, tile_index};
+  auto it = tiles_.find(key);
+  if (it == tiles_.end()) {
+    if (tiles_.size() >= max_tiles_) {
+      functions_.RemoveTile(usage_.back().function);
+      tiles_.erase(usage_.back());
+      usage_.pop_back();
+    }
+    functions_.AddTile(function_);
+    usage_.push_front(key);
+    it = tiles_.emplace(key, Tile()).first;
+    it->second.usage = usage_.begin();
+  } else {
+    usage_.splice(usage_.begin(), usage_, it->second.usage);
+  }
+  int offset = static_cast<int>(index - tile_index * TILE_SIZE);
+  it->second.values[offset] = value;
+  it->second.known.set(offset);
+}
+
+double SampleCache::Get(int level, long long index,
+                        const std::function<double(double)>& evaluate) {
+  double value = 0.0;
+  if (Find(level, index, value) == false) {
+    value = evaluate(Position(level, index));
+    Store(level, index, value);
+  }
+  return value;
+}
+
+void SampleCache::Clear() noexcept {
+  tiles_.clear();
+  usage_.clear();
+  functions_.Clear();
+}
+
+size_t SampleCache::Size() const noexcept { return tiles_.size(); }
+
+SampleCache::Grid SampleCache::MakeGrid(double min, double max,
+                                        int size) noexcept {
+  Grid grid;
+  double step = (max - min) / size;
+  if (size <= 0 || std::isfinite(step) == false || step <= 0.0) return grid;
+  grid.level = static_cast<int>(std::lround(std::log2(step)));
+  grid.first = static_cast<long long>(std::ceil(std::ldexp(min, -grid.level)));
+  long long last =
+      static_cast<long long>(std::floor(std::ldexp(max, -grid.level)));
+  grid.count = static_cast<int>(last - grid.first + 1);
+  return grid;
+}
+
+double SampleCache::Position(int level, long long index) noexcept {
+  return std::ldexp(static_cast<double>(index), level);
+}
+
+bool SampleCache::FindOnLevel(int level, long long index, double& value) {
+  long long tile_index = TileIndex(index);
+  auto it = tiles_.find(TileKey{function_, level, tile_index});
+  if (it == tiles_.end()) return false;
+  int offset = static_cast<int>(index - tile_index * TILE_SIZE);
+  if (it->second.known.test(offset) == false) return false;
+  usage_.splice(usage_.begin(), usage_, it->second.usage);
+  value = it->second.values[offset];
+  return true;
+}
+
+int SampleCache::FunctionIds::Select(const std::string& expression,
+                                     bool degree) {
+  std::pair<std::string, bool> key(expression, degree);
+  auto it = ids_.find(key);
+  if (it != ids_.end()) return it->second;
+  for (auto unused = ids_.begin(); unused != ids_.end();) {
+    if (tiles_.count(unused->second) == 0)
+      unused = ids_.erase(unused);
+    else
+      ++unused;
+  }
+  return ids_.emplace(key, next_++).first->second;
+}
+
+void SampleCache::FunctionIds::AddTile(int id) { tiles_[id]++; }
+
+void SampleCache::FunctionIds::RemoveTile(int id) {
+  auto it = tiles_.find(id);
+  if (it != tiles_.end() && --it->second == 0) tiles_.erase(it);
+}
+
+void SampleCache::FunctionIds::Clear() noexcept {
+  ids_.clear();
+  tiles_.clear();
+}
+
+size_t SampleCache::FunctionIds::Size() const noexcept { return ids_.size(); }
+
+size_t SampleCache::TileKeyHash::operator()(
+    const TileKey& key) const noexcept {
+  size_t hash = std::hash<long long>()(key.index);
+  hash ^= std::hash<int>()(key.level) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^=
+      std::hash<int>()(key.function) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+/* Floor division, so negative indexes get their own tiles. */
+long long SampleCache::TileIndex(long long index) noexcept {
+  return index >= 0 ? index / TILE_SIZE : -(-(index + 1) / TILE_SIZE) - 1;
+}
+
+}  // namespace s21
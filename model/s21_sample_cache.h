@@ -0,0 +1,109 @@
+#ifndef S21_SAMPLE_CACHE_H
+#define S21_SAMPLE_CACHE_H
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace s21 {
+
+/* Cache of function samples for graph plotting. Samples are taken on
+ * power-of-two grids: on level L sample with index m has position m * 2^L.
+ * Grid of level L contains every point of coarser levels, so samples are
+ * shared between zoom levels without any rounding. Samples are stored in tiles
+ * of TILE_SIZE neighbouring points. Tiles are kept separately for every
+ * function, i.e. expression and angle mode. The least recently used tiles are
+ * dropped when cache is full. */
+class SampleCache {
+ public:
+  static constexpr int TILE_SIZE = 64;
+  static constexpr size_t DEFAULT_MAX_TILES = 4096;
+  /* How many levels up and down are searched for already known sample. */
+  static constexpr int MAX_LEVEL_DISTANCE = 8;
+
+  /* Ids of functions, i.e. expression and angle mode, with count of cached
+   * tiles of each of them. Functions without tiles are forgotten when a new
+   * function is added, so the map does not grow with every edited expression.
+   * Ids are never reused. */
+  class FunctionIds {
+   public:
+    int Select(const std::string& expression, bool degree);
+    void AddTile(int id);
+    void RemoveTile(int id);
+    void Clear() noexcept;
+    size_t Size() const noexcept;
+
+   private:
+    std::map<std::pair<std::string, bool>, int> ids_;
+    std::unordered_map<int, size_t> tiles_;
+    int next_ = 1;
+  };
+
+  /* Range of grid points of one level. */
+  struct Grid {
+    int level = 0;
+    long long first = 0;
+    int count = 0;
+  };
+
+  explicit SampleCache(size_t max_tiles = DEFAULT_MAX_TILES);
+  ~SampleCache() = default;
+
+  /* Select function, whose samples are looked up and stored. */
+  void SetFunction(const std::string& expression, bool degree);
+  /* Find sample on given level or on any level within MAX_LEVEL_DISTANCE. */
+  bool Find(int level, long long index, double& value);
+  void Store(int level, long long index, double value);
+  /* Return cached sample or evaluate function at its position and store
+   * result. */
+  double Get(int level, long long index,
+             const std::function<double(double)>& evaluate);
+  void Clear() noexcept;
+  size_t Size() const noexcept;
+
+  /* Grid of points within [min, max], whose step is the power of two nearest
+   * to (max - min) / size. */
+  static Grid MakeGrid(double min, double max, int size) noexcept;
+  static double Position(int level, long long index) noexcept;
+
+ private:
+  struct TileKey {
+    int function;
+    int level;
+    long long index;
+    bool operator==(const TileKey& other) const noexcept {
+      return function == other.function && level == other.level &&
+             index == other.index;
+    }
+  };
+
+  struct TileKeyHash {
+    size_t operator()(const TileKey& key) const noexcept;
+  };
+
+  struct Tile {
+    std::array<double, TILE_SIZE> values;
+    std::bitset<TILE_SIZE> known;
+    std::list<TileKey>::iterator usage;
+  };
+
+  size_t max_tiles_;
+  int function_ = 0;
+  FunctionIds functions_;
+  std::unordered_map<TileKey, Tile, TileKeyHash> tiles_;
+  /* Tile keys from the most to the least recently used. */
+  std::list<TileKey> usage_;
+
+  bool FindOnLevel(int level, long long index, double& value);
+  static long long TileIndex(long long index) noexcept;
+};
+
+}  // namespace s21
+
+#endif  // S21_SAMPLE_CACHE_H
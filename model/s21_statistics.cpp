@@ -0,0 +1,102 @@
+#include "s21_statistics.h"
+
+#include <cmath>
+
+namespace s21 {
+
+void Statistics::Add(double value) noexcept {
+  if (std::isfinite(value) == false) {
+    nan_count_++;
+    return;
+  }
+  if (count_ == 0) {
+    min_ = max_ = value;
+  } else {
+    if (value < min_) min_ = value;
+    if (value > max_) max_ = value;
+  }
+  count_++;
+  double delta = value - mean_;
+  mean_ += delta / count_;
+  m2_ += delta * (value - mean_);
+}
+
+void Statistics::Add(const double* values, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) Add(values[i]);
+}
+
+/* Chan's formula for combining mean and squared deviations of two parts. */
+void Statistics::Merge(const Statistics& other) noexcept {
+  nan_count_ += other.nan_count_;
+  if (other.count_ == 0) return;
+  if (count_ == 0) {
+    size_t nan_count = nan_count_;
+    *this = other;
+    nan_count_ = nan_count;
+    return;
+  }
+  double total = static_cast<double>(count_ + other.count_);
+  double delta = other.mean_ - mean_;
+  mean_ += delta * other.count_ / total;
+  m2_ += other.m2_ + delta * delta * count_ * other.count_ / total;
+  count_ += other.count_;
+  if (other.min_ < min_) min_ = other.min_;
+  if (other.max_ > max_) max_ = other.max_;
+}
+
+size_t Statistics::GetCount() const noexcept { return count_; }
+
+size_t Statistics::GetNanCount() const noexcept { return nan_count_; }
+
+double Statistics::GetMin() const noexcept { return count_ ? min_ : NAN; }
+
+double Statistics::GetMax() const noexcept { return count_ ? max_ : NAN; }
+
+double Statistics::GetMean() const noexcept { return count_ ? mean_ : NAN; }
+
+double Statistics::GetVariance() const noexcept {
+  return count_ ? m2_ / count_ : NAN;
+}
+
+Histogram::Histogram(double min, double max, size_t bins)
+    : min_(min),
+      max_(max),
+      scale_(max > min ? bins / (max - min) : 0.0),
+      bins_(bins > 0 ? bins : 1, 0) {}
+
+void Histogram::Add(double value) noexcept {
+  if (std::isnan(value)) return;
+  if (value < min_) {
+    underflow_++;
+  } else if (value > max_) {
+    overflow_++;
+  } else {
+    size_t bin = static_cast<size_t>((value - min_) * scale_);
+    bins_[bin < bins_.size() ? bin : bins_.size() - 1]++;
+  }
+}
+
+void Histogram::Add(const double* values, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) Add(values[i]);
+}
+
+void Histogram::Merge(const Histogram& other) noexcept {
+  for (size_t i = 0; i < bins_.size() && i < other.bins_.size(); ++i)
+    bins_[i] += other.bins_[i];
+  underflow_ += other.underflow_;
+  overflow_ += other.overflow_;
+}
+
+const std::vector<size_t>& Histogram::GetBins() const noexcept {
+  return bins_;
+}
+
+size_t Histogram::GetUnderflow() const noexcept { return underflow_; }
+
+size_t Histogram::GetOverflow() const noexcept { return overflow_; }
+
+double Histogram::GetMin() const noexcept { return min_; }
+
+double Histogram::GetMax() const noexcept { return max_; }
+
+}  // namespace s21
@@ -0,0 +1,71 @@
+#ifndef S21_STATISTICS_H
+#define S21_STATISTICS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+
+/* Streaming aggregates of values: count, min, max, mean and variance. Values
+ * are added one by one or by blocks and are not stored. Non-finite values are
+ * only counted. Partial results of separate parts of data can be merged. */
+class Statistics {
+ public:
+  Statistics() = default;
+  ~Statistics() = default;
+
+  void Add(double value) noexcept;
+  void Add(const double* values, size_t count) noexcept;
+  void Merge(const Statistics& other) noexcept;
+
+  /* Number of finite values. */
+  size_t GetCount() const noexcept;
+  /* Number of NaN and infinite values. */
+  size_t GetNanCount() const noexcept;
+  /* NaN if there are no finite values. */
+  double GetMin() const noexcept;
+  double GetMax() const noexcept;
+  double GetMean() const noexcept;
+  /* Population variance. */
+  double GetVariance() const noexcept;
+
+ private:
+  size_t count_ = 0;
+  size_t nan_count_ = 0;
+  double min_ = 0.0;
+  double max_ = 0.0;
+  double mean_ = 0.0;
+  /* Sum of squared deviations from mean, updated by Welford's method. */
+  double m2_ = 0.0;
+};
+
+/* Streaming histogram with 'bins' equal bins over [min, max]. Values out of
+ * range are counted separately, NaN values are ignored. */
+class Histogram {
+ public:
+  Histogram(double min, double max, size_t bins);
+  ~Histogram() = default;
+
+  void Add(double value) noexcept;
+  void Add(const double* values, size_t count) noexcept;
+  /* Histograms must have the same range and number of bins. */
+  void Merge(const Histogram& other) noexcept;
+
+  const std::vector<size_t>& GetBins() const noexcept;
+  size_t GetUnderflow() const noexcept;
+  size_t GetOverflow() const noexcept;
+  double GetMin() const noexcept;
+  double GetMax() const noexcept;
+
+ private:
+  double min_;
+  double max_;
+  double scale_;
+  std::vector<size_t> bins_;
+  size_t underflow_ = 0;
+  size_t overflow_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // S21_STATISTICS_H
@@ -0,0 +1,156 @@
+#include "s21_surface_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+namespace {
+
+/* Floor division, so negative indexes get their own tiles. */
+long long TileIndex(long long index) noexcept {
+  const long long size = SurfaceCache::TILE_SIZE;
+  return index >= 0 ? index / size : -(-(index + 1) / size) - 1;
+}
+
+}  // namespace
+
+SurfaceCache::SurfaceCache(size_t max_tiles)
+    : max_tiles_(max_tiles > 0 ? max_tiles : 1) {}
+
+void SurfaceCache::SetFunction(const std::string& expression, bool degree) {
+  function_ = functions_.Select(expression, degree);
+}
+
+/* Cached tiles are copied at once, so they may be evicted later by tiles
+ * evaluated for the same grid. */
+bool SurfaceCache::Fill(const Grid& grid, const Evaluator& evaluate,
+                        double* values, unsigned threads) {
+  if (grid.x.count <= 0 || grid.y.count <= 0) return true;
+  long long first_x = TileIndex(grid.x.first);
+  long long last_x = TileIndex(grid.x.first + grid.x.count - 1);
+  long long first_y = TileIndex(grid.y.first);
+  long long last_y = TileIndex(grid.y.first + grid.y.count - 1);
+  std::vector<TileKey> missing;
+  for (long long ty = first_y; ty <= last_y; ++ty) {
+    for (long long tx = first_x; tx <= last_x; ++tx) {
+      TileKey key{function_, grid.x.level, grid.y.level, tx, ty};
+      const std::vector<double>* tile = Find(key);
+      if (tile == nullptr)
+        missing.push_back(key);
+      else
+        CopyTile(grid, key, tile->data(), values);
+    }
+  }
+
+  std::vector<std::vector<double>> computed(missing.size());
+  std::vector<char> done(missing.size(), 0);
+  std::atomic<bool> stopped{false};
+  ParallelFor(
+      missing.size(),
+      [&](size_t i) {
+        if (stopped.load(std::memory_order_relaxed) == true) return;
+        if (EvaluateTile(evaluate, missing[i], computed[i]) == true)
+          done[i] = 1;
+        else
+          stopped.store(true, std::memory_order_relaxed);
+      },
+      threads);
+
+  for (size_t i = 0; i < missing.size(); ++i) {
+    if (done[i] == 0) {
+      computed[i].assign(TILE_SIZE * TILE_SIZE, NAN);
+      CopyTile(grid, missing[i], computed[i].data(), values);
+    } else {
+      CopyTile(grid, missing[i], computed[i].data(), values);
+      Store(missing[i], std::move(computed[i]));
+    }
+  }
+  return stopped.load() == false;
+}
+
+void SurfaceCache::Clear() noexcept {
+  tiles_.clear();
+  usage_.clear();
+  functions_.Clear();
+}
+
+size_t SurfaceCache::Size() const noexcept { return tiles_.size(); }
+
+SurfaceCache::Grid SurfaceCache::MakeGrid(double min_x, double max_x,
+                                          int size_x, double min_y,
+                                          double max_y, int size_y) noexcept {
+  return Grid{SampleCache::MakeGrid(min_x, max_x, size_x),
+              SampleCache::MakeGrid(min_y, max_y, size_y)};
+}
+
+const std::vector<double>* SurfaceCache::Find(const TileKey& key) {
+  auto it = tiles_.find(key);
+  if (it == tiles_.end()) return nullptr;
+  usage_.splice(usage_.begin(), usage_, it->second.usage);
+  return &it->second.values;
+}
+
+void SurfaceCache::Store(const TileKey& key, std::vector<double>&& values) {
+  if (tiles_.size() >= max_tiles_) {
+    functions_.RemoveTile(usage_.back().function);
+    tiles_.erase(usage_.back());
+    usage_.pop_back();
+  }
+  functions_.AddTile(key.function);
+  usage_.push_front(key);
+  tiles_[key] = Tile{std::move(values), usage_.begin()};
+}
+
+/* Tile values are stored row by row. */
+bool SurfaceCache::EvaluateTile(const Evaluator& evaluate, const TileKey& key,
+                                std::vector<double>& values) {
+  const size_t count = TILE_SIZE * TILE_SIZE;
+  std::vector<double> x(count), y(count);
+  for (int row = 0; row < TILE_SIZE; ++row) {
+    double y_value = SampleCache::Position(
+        key.level_y, key.index_y * TILE_SIZE + row);
+    for (int col = 0; col < TILE_SIZE; ++col) {
+      x[row * TILE_SIZE + col] = SampleCache::Position(
+          key.level_x, key.index_x * TILE_SIZE + col);
+      y[row * TILE_SIZE + col] = y_value;
+    }
+  }
+  values.resize(count);
+  return evaluate(x.data(), y.data(), values.data(), count);
+}
+
+/* Copy part of tile that lies inside grid. */
+void SurfaceCache::CopyTile(const Grid& grid, const TileKey& key,
+                            const double* tile, double* values) {
+  long long tile_x = key.index_x * TILE_SIZE;
+  long long tile_y = key.index_y * TILE_SIZE;
+  long long from_x = std::max(tile_x, grid.x.first);
+  long long to_x = std::min(tile_x + TILE_SIZE, grid.x.first + grid.x.count);
+  long long from_y = std::max(tile_y, grid.y.first);
+  long long to_y = std::min(tile_y + TILE_SIZE, grid.y.first + grid.y.count);
+  for (long long j = from_y; j < to_y; ++j) {
+    const double* source = tile + (j - tile_y) * TILE_SIZE + (from_x - tile_x);
+    double* target = values + (j - grid.y.first) * grid.x.count +
+                     (from_x - grid.x.first);
+    std::copy(source, source + (to_x - from_x), target);
+  }
+}
+
+size_t SurfaceCache::TileKeyHash::operator()(
+    const TileKey& key) const noexcept {
+  size_t hash = std::hash<long long>()(key.index_x);
+  auto combine = [&hash](size_t value) {
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  };
+  combine(std::hash<long long>()(key.index_y));
+  combine(std::hash<int>()(key.level_x));
+  combine(std::hash<int>()(key.level_y));
+  combine(std::hash<int>()(key.function));
+  return hash;
+}
+
+}  // namespace s21
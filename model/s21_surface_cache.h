@@ -0,0 +1,93 @@
+#ifndef S21_SURFACE_CACHE_H
+#define S21_SURFACE_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "s21_sample_cache.h"
+
+namespace s21 {
+
+/* Cache of values of f(x, y) for heatmaps. Points lie on power-of-two grids
+ * along each axis, as in SampleCache, and are kept in square tiles of
+ * TILE_SIZE x TILE_SIZE values, which fit into processor cache. Tiles that
+ * are missing are evaluated in parallel, so pan reevaluates only tiles that
+ * come into view. The least recently used tiles are dropped when cache is
+ * full. */
+class SurfaceCache {
+ public:
+  static constexpr int TILE_SIZE = 32;
+  static constexpr size_t DEFAULT_MAX_TILES = 2048;
+
+  struct Grid {
+    SampleCache::Grid x;
+    SampleCache::Grid y;
+  };
+
+  /* Evaluate 'count' points (x[i], y[i]) into z. Called from several threads
+   * at once. Returning false stops evaluation, e.g. when request is
+   * cancelled. */
+  typedef std::function<bool(const double* x, const double* y, double* z,
+                             size_t count)>
+      Evaluator;
+
+  explicit SurfaceCache(size_t max_tiles = DEFAULT_MAX_TILES);
+  ~SurfaceCache() = default;
+
+  void SetFunction(const std::string& expression, bool degree);
+  /* Fill values of all grid points row by row, starting from the lowest y.
+   * Returns false if evaluation was stopped, values are incomplete then. */
+  bool Fill(const Grid& grid, const Evaluator& evaluate, double* values,
+            unsigned threads = 0);
+  void Clear() noexcept;
+  size_t Size() const noexcept;
+
+  static Grid MakeGrid(double min_x, double max_x, int size_x, double min_y,
+                       double max_y, int size_y) noexcept;
+
+ private:
+  struct TileKey {
+    int function;
+    int level_x;
+    int level_y;
+    long long index_x;
+    long long index_y;
+    bool operator==(const TileKey& other) const noexcept {
+      return function == other.function && level_x == other.level_x &&
+             level_y == other.level_y && index_x == other.index_x &&
+             index_y == other.index_y;
+    }
+  };
+
+  struct TileKeyHash {
+    size_t operator()(const TileKey& key) const noexcept;
+  };
+
+  struct Tile {
+    std::vector<double> values;
+    std::list<TileKey>::iterator usage;
+  };
+
+  size_t max_tiles_;
+  int function_ = 0;
+  SampleCache::FunctionIds functions_;
+  std::unordered_map<TileKey, Tile, TileKeyHash> tiles_;
+  /* Tile keys from the most to the least recently used. */
+  std::list<TileKey> usage_;
+
+  const std::vector<double>* Find(const TileKey& key);
+  void Store(const TileKey& key, std::vector<double>&& values);
+  static bool EvaluateTile(const Evaluator& evaluate, const TileKey& key,
+                           std::vector<double>& values);
+  static void CopyTile(const Grid& grid, const TileKey& key,
+                       const double* tile, double* values);
+};
+
+}  // namespace s21
+
+#endif  // S21_SURFACE_CACHE_H
@@ -0,0 +1,226 @@
+#include "s21_table.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "s21_format.h"
+
+namespace s21 {
+
+namespace {
+
+class Writer {
+ public:
+  explicit Writer(int fd) : fd_(fd) {}
+  virtual ~Writer() = default;
+  virtual bool Append(const char* data, size_t size) = 0;
+  /* Flush the rest of data, file descriptor stays open. */
+  virtual bool Finish() = 0;
+
+ protected:
+  int fd_;
+};
+
+class BufferedWriter : public Writer {
+ public:
+  explicit BufferedWriter(int fd) : Writer(fd), buffer_(Table::BUFFER_SIZE) {}
+
+  bool Append(const char* data, size_t size) override {
+    if (used_ + size > buffer_.size() && Flush() == false) return false;
+    if (size > buffer_.size()) return WriteAll(data, size);
+    std::memcpy(buffer_.data() + used_, data, size);
+    used_ += size;
+    return true;
+  }
+
+  bool Finish() override { return Flush(); }
+
+ private:
+  std::vector<char> buffer_;
+  size_t used_ = 0;
+
+  bool Flush() {
+    bool done = WriteAll(buffer_.data(), used_);
+    used_ = 0;
+    return done;
+  }
+
+  bool WriteAll(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t written = write(fd_, data, size);
+      if (written < 0) return false;
+      data += written;
+      size -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+};
+
+/* Allocate disk space of file range. macOS has no posix_fallocate, there
+ * space past the end of file is reserved by F_PREALLOCATE, contiguous if
+ * possible, and file is extended over it. */
+bool Allocate(int fd, off_t offset, off_t size) {
+#ifdef __APPLE__
+  fstore_t store = {F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, size, 0};
+  if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+    store.fst_flags = F_ALLOCATEALL;
+    if (fcntl(fd, F_PREALLOCATE, &store) == -1) return false;
+  }
+  return ftruncate(fd, offset + size) == 0;
+#else
+  return posix_fallocate(fd, offset, size) == 0;
+#endif
+}
+
+/* File space is allocated before it is mapped, so running out of disk is
+ * reported as error instead of signal on write to mapped page. */
+class MappedWriter : public Writer {
+ public:
+  explicit MappedWriter(int fd) : Writer(fd) {}
+  ~MappedWriter() override { Unmap(); }
+
+  bool Append(const char* data, size_t size) override {
+    while (size > 0) {
+      if (used_ == Table::MAP_CHUNK && Map() == false) return false;
+      size_t part = std::min(size, Table::MAP_CHUNK - used_);
+      std::memcpy(window_ + used_, data, part);
+      used_ += part;
+      data += part;
+      size -= part;
+    }
+    return true;
+  }
+
+  bool Finish() override {
+    size_t size = window_ == nullptr ? 0 : offset_ + used_;
+    Unmap();
+    return ftruncate(fd_, static_cast<off_t>(size)) == 0;
+  }
+
+ private:
+  char* window_ = nullptr;
+  /* File offset of window and bytes used in it. */
+  size_t offset_ = 0;
+  size_t used_ = Table::MAP_CHUNK;
+
+  bool Map() {
+    if (window_ != nullptr) offset_ += Table::MAP_CHUNK;
+    Unmap();
+    if (Allocate(fd_, static_cast<off_t>(offset_),
+                 static_cast<off_t>(Table::MAP_CHUNK)) == false)
+      return false;
+    void* data = mmap(nullptr, Table::MAP_CHUNK, PROT_WRITE, MAP_SHARED, fd_,
+                      static_cast<off_t>(offset_));
+    if (data == MAP_FAILED) return false;
+    madvise(data, Table::MAP_CHUNK, MADV_SEQUENTIAL);
+    window_ = static_cast<char*>(data);
+    used_ = 0;
+    return true;
+  }
+
+  void Unmap() {
+    if (window_ == nullptr) return;
+    munmap(window_, Table::MAP_CHUNK);
+    window_ = nullptr;
+  }
+};
+
+}  // namespace
+
+Table::Table(const Options& options) : options_(options) {}
+
+unsigned long long Table::Rows(double a, double b, double step) noexcept {
+  double steps = (b - a) / step;
+  if (std::isfinite(a) == false || std::isfinite(b) == false ||
+      std::isfinite(steps) == false || steps < 0)
+    return 0;
+  /* Tolerance keeps b when range is a whole number of steps, but step that
+   * is not exact in binary gives quotient slightly below it. Count is
+   * checked in double, conversion of larger value is undefined. */
+  double last = std::floor(steps * (1 + 1e-12));
+  if (last >= static_cast<double>(MAX_ROWS)) return 0;
+  return static_cast<unsigned long long>(last) + 1;
+}
+
+/* Expression is checked once with empty block, so every block is evaluated
+ * successfully. x of row i is a + i * step, so error does not accumulate. */
+Table::Status Table::Write(const Calculation& calculation, double a, double b,
+                           double step, const std::string& path,
+                           const Progress& progress) const {
+  unsigned long long rows = Rows(a, b, step);
+  if (rows == 0) return RANGE_ERROR;
+  if (calculation.GetResults(nullptr, nullptr, 0) == false)
+    return CALCULATE_ERROR;
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return OPEN_ERROR;
+  std::unique_ptr<Writer> writer;
+  if (options_.output == MAPPED)
+    writer.reset(new MappedWriter(fd));
+  else
+    writer.reset(new BufferedWriter(fd));
+
+  bool csv = options_.format == Dataset::CSV;
+  std::vector<double> x(BLOCK_SIZE), y(BLOCK_SIZE);
+  std::vector<char> text(csv ? BLOCK_SIZE * (2 * Format::BUFFER_SIZE + 2)
+                             : 0);
+  std::vector<double> pairs(csv ? 0 : 2 * BLOCK_SIZE);
+  Status status = COMPLETED;
+  if (csv == true) {
+    const char header[] = {'x', options_.separator, 'y', '\n'};
+    if (writer->Append(header, sizeof(header)) == false) status = WRITE_ERROR;
+  }
+  for (unsigned long long first = 0; first < rows && status == COMPLETED;
+       first += BLOCK_SIZE) {
+    size_t count = static_cast<size_t>(
+        std::min<unsigned long long>(BLOCK_SIZE, rows - first));
+    for (size_t i = 0; i < count; ++i) x[i] = a + (first + i) * step;
+    calculation.GetResults(x.data(), y.data(), count);
+    bool written;
+    if (csv == true) {
+      size_t size = FormatCsv(x.data(), y.data(), count, text.data());
+      written = writer->Append(text.data(), size);
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        pairs[2 * i] = x[i];
+        pairs[2 * i + 1] = y[i];
+      }
+      written = writer->Append(reinterpret_cast<const char*>(pairs.data()),
+                               2 * count * sizeof(double));
+    }
+    if (written == false)
+      status = WRITE_ERROR;
+    else if (progress && progress(first + count) == false)
+      status = CANCELLED;
+  }
+  if (writer->Finish() == false && status == COMPLETED) status = WRITE_ERROR;
+  writer.reset();
+  if (close(fd) != 0 && status == COMPLETED) status = WRITE_ERROR;
+  return status;
+}
+
+size_t Table::FormatCsv(const double* x, const double* y, size_t count,
+                        char* output) const {
+  char* end = output;
+  for (size_t i = 0; i < count; ++i) {
+    end = FormatNumber(end, x[i]);
+    *end++ = options_.separator;
+    end = FormatNumber(end, y[i]);
+    *end++ = '\n';
+  }
+  return static_cast<size_t>(end - output);
+}
+
+char* Table::FormatNumber(char* first, double value) const {
+  return options_.precision > 0
+             ? Format::Precise(first, value, options_.precision)
+             : Format::Shortest(first, value);
+}
+
+}  // namespace s21
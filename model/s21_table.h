@@ -0,0 +1,78 @@
+#ifndef S21_TABLE_H
+#define S21_TABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "s21_calculation.h"
+#include "s21_dataset.h"
+
+namespace s21 {
+
+/* Table of expression values for x from a to b with step, written straight to
+ * file. Rows are evaluated and formatted by blocks of BLOCK_SIZE, so table is
+ * never stored whole.
+ * CSV: header "x,y" and one row per line, numbers are separated by
+ * 'separator'.
+ * BINARY: rows of two native doubles x and y without any header, the same
+ * format Dataset reads with two columns.
+ * BUFFERED output collects data in buffer of BUFFER_SIZE and writes it by
+ * system calls. MAPPED output reserves file space by MAP_CHUNK and copies
+ * data into mapped window of it, file is cut to written size at the end. */
+class Table {
+ public:
+  enum Output { BUFFERED, MAPPED };
+  enum Status {
+    COMPLETED,
+    CANCELLED,
+    RANGE_ERROR,
+    CALCULATE_ERROR,
+    OPEN_ERROR,
+    WRITE_ERROR
+  };
+
+  static constexpr size_t BLOCK_SIZE = 4096;
+  static constexpr size_t BUFFER_SIZE = 1 << 20;
+  static constexpr size_t MAP_CHUNK = 64 << 20;
+  /* Longer ranges are refused, their tables would take terabytes. */
+  static constexpr unsigned long long MAX_ROWS = 1ULL << 40;
+
+  struct Options {
+    Dataset::Format format = Dataset::CSV;
+    Output output = BUFFERED;
+    char separator = ',';
+    /* Significant digits of CSV numbers, up to Format::MAX_PRECISION. 0
+     * gives the shortest form that reads back to the same double. */
+    int precision = 15;
+  };
+
+  /* Receives number of rows written so far after every block. Returning
+   * false stops writing. */
+  typedef std::function<bool(unsigned long long rows)> Progress;
+
+  Table() = default;
+  explicit Table(const Options& options);
+  ~Table() = default;
+
+  /* Number of rows of range, 0 if step does not lead from a to b or range
+   * has more than MAX_ROWS rows. The last row is b if range is a whole
+   * number of steps. */
+  static unsigned long long Rows(double a, double b, double step) noexcept;
+
+  /* Expression must be compiled. File is replaced. */
+  Status Write(const Calculation& calculation, double a, double b,
+               double step, const std::string& path,
+               const Progress& progress = nullptr) const;
+
+ private:
+  Options options_{};
+
+  size_t FormatCsv(const double* x, const double* y, size_t count,
+                   char* output) const;
+  char* FormatNumber(char* first, double value) const;
+};
+
+}  // namespace s21
+
+#endif  // S21_TABLE_H
@@ -243,3 +243,146 @@ TEST(CalculationSuite, UsingComma) {
   EXPECT_NEAR(instance.GetResult(9.0), 13.8, EPS);
   EXPECT_NEAR(instance.GetResult(0.000012), 4.800012, EPS);
 }
+
+TEST(CalculationSuite, Stats) {
+  s21::Calculation instance;
+  EXPECT_NEAR(instance.GetResult("2 + sin(x)*3", 0.0), 2.0, EPS);
+  EXPECT_NEAR(instance.GetResult(1.0), 2.0 + 3.0 * sin(1.0), EPS);
+  const s21::Calculation::Stats& stats = instance.GetStats();
+  if (s21::Calculation::IsStatsEnabled()) {
+    EXPECT_EQ(stats.normalize_calls, 1U);
+    EXPECT_EQ(stats.tokenize_calls, 1U);
+    EXPECT_EQ(stats.shunting_yard_calls, 1U);
+    EXPECT_EQ(stats.evaluate_calls, 2U);
+    EXPECT_EQ(stats.tokens, 8U);
+    EXPECT_EQ(stats.peak_stack_depth, 3U);
+  } else {
+    EXPECT_EQ(stats.evaluate_calls, 0U);
+    EXPECT_EQ(stats.tokens, 0U);
+  }
+  instance.ResetStats();
+  EXPECT_EQ(stats.evaluate_calls, 0U);
+  EXPECT_EQ(stats.evaluate_ns, 0U);
+  EXPECT_EQ(stats.tokens, 0U);
+  EXPECT_EQ(stats.peak_stack_depth, 0U);
+}
+
+TEST(CalculationSuite, IncrementalParse) {
+  const std::vector<std::string> expressions = {
+      "2.8*1.9 + (-2)^ x",  "  (((2.8*1.9)^x)) +-(sqrt(2 * x))",
+      "sin(1/3)sin(2*1.89)", "1e5 + 2,5e-3x",
+      "x*tan(x)*sin(x)^x",   "2 mod-1 + ~x + asin(x/10)",
+      "2^2x + ln(x)log(x)",  "((1+2)*(3-4)) / (5 mod 3)",
+      "-(2^-(3^(sin(x)-1)))*~cos(+x^2^-1)"};
+  s21::Calculation live;
+  s21::Calculation full;
+  auto compare = [&](const std::string& expr) {
+    double expected = full.GetResult(expr, 1.5);
+    live.SetX(1.5);
+    live.UpdateExpression(expr);
+    double result = live.GetResult();
+    EXPECT_EQ(live.GetStatus(), full.GetStatus()) << expr;
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << expr;
+    } else {
+      EXPECT_NEAR(result, expected, EPS) << expr;
+    }
+  };
+  for (const std::string& expr : expressions) {
+    for (size_t i = 0; i <= expr.size(); ++i) compare(expr.substr(0, i));
+    for (size_t i = expr.size(); i > 0; --i) compare(expr.substr(0, i));
+    for (size_t i = 0; i < expr.size(); ++i) {
+      std::string edited = expr;
+      edited.insert(i, "9");
+      compare(edited);
+      compare(expr);
+      edited = expr;
+      edited.erase(i, 1);
+      compare(edited);
+      compare(expr);
+    }
+  }
+}
+
+TEST(CalculationSuite, IncrementalParseStats) {
+  s21::Calculation instance;
+  instance.UpdateExpression("1 + 2 + 3 + 4 + 5");
+  EXPECT_NEAR(instance.GetResult(), 15.0, EPS);
+  instance.ResetStats();
+  instance.UpdateExpression("1 + 2 + 3 + 4 + 56");
+  EXPECT_NEAR(instance.GetResult(), 66.0, EPS);
+  instance.UpdateExpression("1 + 2 + 3 + 4 + 56 * 2");
+  EXPECT_NEAR(instance.GetResult(), 122.0, EPS);
+  if (s21::Calculation::IsStatsEnabled()) {
+    EXPECT_EQ(instance.GetStats().tokenize_calls, 2U);
+    EXPECT_EQ(instance.GetStats().tokens, 4U);
+  }
+  instance.SetExpression("1 + 2 + 3 + 4 + 56 * 2");
+  EXPECT_NEAR(instance.GetResult(), 122.0, EPS);
+  if (s21::Calculation::IsStatsEnabled()) {
+    EXPECT_EQ(instance.GetStats().tokens, 15U);
+  }
+}
+
+TEST(CalculationSuite, BlockEvaluation) {
+  const std::vector<std::string> expressions = {
+      "2 + sin(x)*3", "x^2 - x mod 3", "-(x)/(1 + x^2)", "acos(x/100)", "7"};
+  std::vector<double> x;
+  for (int i = -50; i <= 50; ++i) x.push_back(i * 1.5);
+  std::vector<double> block(x.size());
+  s21::Calculation instance;
+  s21::Calculation scalar;
+  for (int degree = 0; degree < 2; ++degree) {
+    if (degree) {
+      instance.SetDegree();
+      scalar.SetDegree();
+    }
+    for (const std::string& expression : expressions) {
+      instance.SetExpression(expression);
+      ASSERT_TRUE(instance.Compile());
+      ASSERT_TRUE(instance.GetResults(x.data(), block.data(), x.size()));
+      for (size_t i = 0; i < x.size(); ++i) {
+        double expected = scalar.GetResult(expression, x[i]);
+        if (std::isnan(expected)) {
+          EXPECT_TRUE(std::isnan(block[i]));
+        } else {
+          EXPECT_NEAR(block[i], expected, EPS);
+        }
+      }
+    }
+  }
+  instance.SetExpression("2 + ");
+  instance.Compile();
+  EXPECT_FALSE(instance.GetResults(x.data(), block.data(), x.size()));
+  instance.SetExpression("2 + )");
+  EXPECT_FALSE(instance.Compile());
+  EXPECT_FALSE(instance.GetResults(x.data(), block.data(), x.size()));
+  instance.SetExpression("");
+  EXPECT_FALSE(instance.Compile());
+  EXPECT_FALSE(instance.GetResults(x.data(), block.data(), x.size()));
+}
+
+TEST(CalculationSuite, VariableY) {
+  s21::Calculation instance;
+  instance.SetY(3.0);
+  EXPECT_NEAR(instance.GetY(), 3.0, EPS);
+  EXPECT_NEAR(instance.GetResult("x*y + 2y", 2.0), 12.0, EPS);
+  EXPECT_NEAR(instance.GetResult("sin(y)*y(x)", 2.0), std::sin(3.0) * 6.0,
+              EPS);
+  instance.GetResult("xy", 2.0);
+  EXPECT_EQ(instance.GetStatus(), s21::Calculation::PARSE_ERROR);
+  instance.GetResult("yy", 2.0);
+  EXPECT_EQ(instance.GetStatus(), s21::Calculation::PARSE_ERROR);
+  instance.GetResult("y5", 2.0);
+  EXPECT_EQ(instance.GetStatus(), s21::Calculation::PARSE_ERROR);
+  EXPECT_TRUE(std::isnan(s21::Calculation().GetResult("y", 1.0)));
+
+  const double x[] = {1.0, 2.0, -3.0}, y[] = {0.5, -1.0, 4.0};
+  double z[3] = {};
+  instance.SetExpression("x^2 - y");
+  ASSERT_TRUE(instance.Compile());
+  ASSERT_TRUE(instance.GetResults(x, y, z, 3));
+  for (int i = 0; i < 3; ++i) EXPECT_NEAR(z[i], x[i] * x[i] - y[i], EPS);
+  ASSERT_TRUE(instance.GetResults(x, z, 3));
+  for (int i = 0; i < 3; ++i) EXPECT_TRUE(std::isnan(z[i]));
+}
@@ -378,3 +378,275 @@ TEST(CommonSuite, ShiftMonths) {
   date1 = date1.shiftMonths(25);
   EXPECT_TRUE(date2 == date1);
 }
+
+TEST(CommonSuite, DateConstexpr) {
+  constexpr s21::Date date(29, 2, 2024);
+  static_assert(date.getDay() == 29 && date.getMonth() == 2 &&
+                    date.getYear() == 2024,
+                "Date must be usable in constant expressions");
+  static_assert((date + 1) == s21::Date(1, 3, 2024), "");
+  static_assert((s21::Date(1, 1, 2000) | s21::Date(1, 1, 1900)) == 36524, "");
+  static_assert(date.shiftMonths(12) == s21::Date(28, 2, 2025), "");
+  static_assert(s21::Date::daysInMonth(2, 1900) == 28, "");
+  EXPECT_EQ(date.getDay(), 29);
+}
+
+/* Every day of four centuries is walked through by day, month and year and
+ * compared with serial arithmetic. */
+TEST(CommonSuite, DateSerial) {
+  s21::Date first(1, 1, 1900);
+  int day = 1, month = 1, year = 1900;
+  for (int i = 0; year < 2300; ++i) {
+    s21::Date date = first + i;
+    ASSERT_EQ(date.getDay(), day);
+    ASSERT_EQ(date.getMonth(), month);
+    ASSERT_EQ(date.getYear(), year);
+    ASSERT_TRUE(date == s21::Date(day, month, year));
+    ASSERT_EQ(date | first, i);
+    if (++day > s21::Date::daysInMonth(month, year)) {
+      day = 1;
+      if (++month > 12) {
+        month = 1;
+        year++;
+      }
+    }
+  }
+}
+
+TEST(CommonSuite, ShiftMonthsOvercap) {
+  EXPECT_EQ(s21::Date(31, 1, 2025).shiftMonthsOvercap(1),
+            s21::Date(3, 3, 2025));
+  EXPECT_EQ(s21::Date(31, 1, 2024).shiftMonthsOvercap(1),
+            s21::Date(2, 3, 2024));
+  EXPECT_EQ(s21::Date(29, 2, 2024).shiftMonthsOvercap(12),
+            s21::Date(1, 3, 2025));
+  EXPECT_EQ(s21::Date(30, 1, 2023).shiftMonthsOvercap(1),
+            s21::Date(2, 3, 2023));
+  EXPECT_EQ(s21::Date(15, 1, 2023).shiftMonthsOvercap(13),
+            s21::Date(15, 2, 2024));
+  static_assert(s21::Date(31, 3, 2023).shiftMonthsOvercap(1) ==
+                    s21::Date(1, 5, 2023),
+                "");
+}
+
+TEST(CommonSuite, ScheduleDays) {
+  s21::Schedule weekly(s21::Schedule::R_DAYS, 7, s21::Date(1, 1, 2024),
+                       s21::Date(10, 1, 2024), s21::Date(29, 1, 2024));
+  std::vector<s21::Date> dates(weekly.begin(), weekly.end());
+  ASSERT_EQ(dates.size(), 3U);
+  EXPECT_EQ(dates[0], s21::Date(15, 1, 2024));
+  EXPECT_EQ(dates[1], s21::Date(22, 1, 2024));
+  EXPECT_EQ(dates[2], s21::Date(29, 1, 2024));
+
+  int count = 0;
+  s21::Date previous(31, 12, 2023);
+  for (s21::Date date :
+       s21::Schedule(s21::Schedule::R_DAYS, 1, s21::Date(1, 1, 2024),
+                     s21::Date(1, 1, 2024), s21::Date(31, 12, 2024))) {
+    EXPECT_EQ(date | previous, 1);
+    previous = date;
+    count++;
+  }
+  EXPECT_EQ(count, 366);
+}
+
+TEST(CommonSuite, ScheduleMonths) {
+  s21::Schedule clip(s21::Schedule::R_MONTHS, 1, s21::Date(31, 1, 2024),
+                     s21::Date(1, 1, 2024), s21::Date(30, 4, 2024));
+  std::vector<s21::Date> dates(clip.begin(), clip.end());
+  ASSERT_EQ(dates.size(), 4U);
+  EXPECT_EQ(dates[0], s21::Date(31, 1, 2024));
+  EXPECT_EQ(dates[1], s21::Date(29, 2, 2024));
+  EXPECT_EQ(dates[2], s21::Date(31, 3, 2024));
+  EXPECT_EQ(dates[3], s21::Date(30, 4, 2024));
+
+  s21::Schedule overcap(s21::Schedule::R_MONTHS_OVERCAP, 1,
+                        s21::Date(31, 1, 2025), s21::Date(1, 2, 2025),
+                        s21::Date(2, 5, 2025));
+  dates.assign(overcap.begin(), overcap.end());
+  ASSERT_EQ(dates.size(), 2U);
+  EXPECT_EQ(dates[0], s21::Date(3, 3, 2025));
+  EXPECT_EQ(dates[1], s21::Date(3, 4, 2025));
+
+  s21::Schedule annual(s21::Schedule::R_MONTHS_OVERCAP, 12,
+                       s21::Date(29, 2, 2024), s21::Date(1, 1, 2024),
+                       s21::Date(1, 3, 2028));
+  dates.assign(annual.begin(), annual.end());
+  ASSERT_EQ(dates.size(), 5U);
+  EXPECT_EQ(dates[1], s21::Date(1, 3, 2025));
+  EXPECT_EQ(dates[4], s21::Date(1, 3, 2028));
+}
+
+TEST(CommonSuite, ScheduleEmpty) {
+  s21::Schedule before(s21::Schedule::R_MONTHS, 1, s21::Date(1, 1, 2024),
+                       s21::Date(1, 6, 2024), s21::Date(1, 5, 2024));
+  EXPECT_TRUE(before.begin() == before.end());
+  s21::Schedule after(s21::Schedule::R_DAYS, 3, s21::Date(1, 1, 2025),
+                      s21::Date(1, 1, 2024), s21::Date(31, 12, 2024));
+  EXPECT_TRUE(after.begin() == after.end());
+  s21::Schedule gap(s21::Schedule::R_DAYS, 10, s21::Date(1, 1, 2024),
+                    s21::Date(2, 1, 2024), s21::Date(10, 1, 2024));
+  EXPECT_EQ(std::distance(gap.begin(), gap.end()), 0);
+  static_assert(*s21::Schedule(s21::Schedule::R_MONTHS, 1,
+                               s21::Date(31, 1, 2023), s21::Date(1, 2, 2023),
+                               s21::Date(1, 1, 2024))
+                       .begin() == s21::Date(28, 2, 2023),
+                "");
+}
+
+TEST(CommonSuite, Weekday) {
+  EXPECT_EQ(s21::Date(1, 1, 1900).getWeekday(), 1);
+  EXPECT_EQ(s21::Date(1, 1, 2024).getWeekday(), 1);
+  EXPECT_EQ(s21::Date(1, 6, 2024).getWeekday(), 6);
+  EXPECT_EQ(s21::Date(30, 6, 2024).getWeekday(), 7);
+  static_assert(s21::Date(29, 2, 2000).getWeekday() == 2, "");
+}
+
+TEST(CommonSuite, CalendarAdjust) {
+  s21::Calendar calendar;
+  s21::Date saturday(1, 6, 2024);
+  EXPECT_FALSE(calendar.isBusinessDay(saturday));
+  EXPECT_TRUE(calendar.isBusinessDay(s21::Date(3, 6, 2024)));
+  EXPECT_EQ(calendar.adjust(saturday, s21::Calendar::A_NONE), saturday);
+  EXPECT_EQ(calendar.adjust(saturday, s21::Calendar::A_FOLLOWING),
+            s21::Date(3, 6, 2024));
+  EXPECT_EQ(calendar.adjust(saturday, s21::Calendar::A_PRECEDING),
+            s21::Date(31, 5, 2024));
+  EXPECT_EQ(calendar.adjust(saturday, s21::Calendar::A_MODIFIED_FOLLOWING),
+            s21::Date(3, 6, 2024));
+  EXPECT_EQ(calendar.adjust(s21::Date(29, 6, 2024),
+                            s21::Calendar::A_MODIFIED_FOLLOWING),
+            s21::Date(28, 6, 2024));
+  EXPECT_EQ(calendar.adjust(s21::Date(5, 6, 2024),
+                            s21::Calendar::A_MODIFIED_FOLLOWING),
+            s21::Date(5, 6, 2024));
+
+  EXPECT_FALSE(calendar.setWeekend(0xFE));
+  EXPECT_TRUE(calendar.setWeekend((1 << 5) | (1 << 6)));
+  EXPECT_TRUE(calendar.isBusinessDay(s21::Date(2, 6, 2024)));
+  EXPECT_EQ(calendar.adjust(s21::Date(31, 5, 2024),
+                            s21::Calendar::A_FOLLOWING),
+            s21::Date(2, 6, 2024));
+}
+
+TEST(CommonSuite, CalendarHolidays) {
+  s21::Calendar calendar(2000, 2030);
+  EXPECT_FALSE(calendar.addAnnualHoliday(30, 2));
+  EXPECT_TRUE(calendar.addAnnualHoliday(29, 2));
+  EXPECT_TRUE(
+      calendar.addAnnualHoliday(1, 1, s21::Calendar::OB_NEXT_WEEKDAY));
+  EXPECT_TRUE(
+      calendar.addAnnualHoliday(4, 7, s21::Calendar::OB_NEAREST_WEEKDAY));
+  calendar.addHoliday(s21::Date(12, 6, 2024));
+
+  EXPECT_FALSE(calendar.isBusinessDay(s21::Date(29, 2, 2024)));
+  EXPECT_FALSE(calendar.isBusinessDay(s21::Date(12, 6, 2024)));
+  EXPECT_TRUE(calendar.isBusinessDay(s21::Date(12, 6, 2023)));
+  /* 1.1.2022 is Saturday, 4.7.2021 is Sunday, 4.7.2020 is Saturday and
+   * 1.1.2028 is Saturday. */
+  EXPECT_FALSE(calendar.isBusinessDay(s21::Date(3, 1, 2022)));
+  EXPECT_EQ(calendar.adjust(s21::Date(1, 1, 2022),
+                            s21::Calendar::A_FOLLOWING),
+            s21::Date(4, 1, 2022));
+  EXPECT_FALSE(calendar.isBusinessDay(s21::Date(5, 7, 2021)));
+  EXPECT_FALSE(calendar.isBusinessDay(s21::Date(3, 7, 2020)));
+  EXPECT_TRUE(calendar.isBusinessDay(s21::Date(31, 12, 2027)));
+  EXPECT_FALSE(calendar.isBusinessDay(s21::Date(3, 1, 2028)));
+
+  calendar.clearHolidays();
+  EXPECT_TRUE(calendar.isBusinessDay(s21::Date(12, 6, 2024)));
+}
+
+/* Years out of table are checked by rules, the answer must be the same. */
+TEST(CommonSuite, CalendarTableMatchesRules) {
+  s21::Calendar table(2010, 2030), rules(2010, 2009);
+  for (s21::Calendar* calendar : {&table, &rules}) {
+    calendar->addAnnualHoliday(1, 1, s21::Calendar::OB_NEAREST_WEEKDAY);
+    calendar->addAnnualHoliday(25, 12, s21::Calendar::OB_NEXT_WEEKDAY);
+    calendar->addAnnualHoliday(29, 2);
+    calendar->addHoliday(s21::Date(9, 5, 2020));
+    calendar->addHoliday(s21::Date(10, 5, 2021));
+  }
+  for (s21::Date date(1, 1, 2010); date <= s21::Date(31, 12, 2030); ++date)
+    ASSERT_EQ(table.isBusinessDay(date), rules.isBusinessDay(date));
+}
+
+TEST(CommonSuite, DateParse) {
+  s21::Date date(1, 1, 2000);
+  EXPECT_TRUE(s21::Date::parse("29.02.2024", date));
+  EXPECT_EQ(date, s21::Date(29, 2, 2024));
+  EXPECT_TRUE(s21::Date::parse("1999-12-31", date));
+  EXPECT_EQ(date, s21::Date(31, 12, 1999));
+  const char* wrong[] = {"",           "1.01.2024",   "01.1.2024",
+                         "01.01.24",   "01.01.20245", "29.02.2023",
+                         "00.01.2024", "01.13.2024",  "01/01/2024",
+                         "2024-1-01",  "2024-01-1",   "2024.01.01",
+                         "01.01.1899", "0a.01.2024",  " 1.01.2024",
+                         "2024-02-30", "01-01-2024",  "2024-01-01 "};
+  for (const char* text : wrong) {
+    EXPECT_FALSE(s21::Date::parse(text, date)) << text;
+    EXPECT_EQ(date, s21::Date(31, 12, 1999)) << text;
+  }
+  static_assert(
+      [] {
+        s21::Date parsed(1, 1, 2000);
+        return s21::Date::parse("2024-07-04", parsed) &&
+               parsed == s21::Date(4, 7, 2024);
+      }(),
+      "");
+}
+
+TEST(CommonSuite, DateFormat) {
+  char buffer[s21::Date::FORMAT_SIZE];
+  char* end = s21::Date(4, 7, 2024).format(buffer);
+  EXPECT_STREQ(buffer, "04.07.2024");
+  EXPECT_EQ(end, buffer + 10);
+  s21::Date(4, 7, 2024).format(buffer, s21::Date::ISO);
+  EXPECT_STREQ(buffer, "2024-07-04");
+  (s21::Date(31, 12, 9999) + 1).format(buffer, s21::Date::ISO);
+  EXPECT_STREQ(buffer, "10000-01-01");
+
+  s21::Date parsed(1, 1, 2000);
+  for (s21::Date date(1, 1, 1900); date < s21::Date(1, 1, 2100);
+       date += 13) {
+    date.format(buffer);
+    ASSERT_TRUE(s21::Date::parse(buffer, parsed));
+    ASSERT_EQ(parsed, date);
+    date.format(buffer, s21::Date::ISO);
+    ASSERT_TRUE(s21::Date::parse(buffer, parsed));
+    ASSERT_EQ(parsed, date);
+  }
+}
+
+TEST(CommonSuite, BatchCivil) {
+  const s21::Date first(1, 1, 1900), last(31, 12, 2500);
+  const size_t count = static_cast<size_t>(last | first) + 1;
+  std::vector<int> serials(count), days(count), months(count), years(count),
+      back(count), buckets(count);
+  for (size_t i = 0; i < count; ++i)
+    serials[i] = (first + static_cast<int>(i)).getSerial();
+  s21::Date::toCivil(serials.data(), days.data(), months.data(), years.data(),
+                     count);
+  s21::Date::fromCivil(days.data(), months.data(), years.data(), back.data(),
+                       count);
+  s21::Date::toMonthBuckets(serials.data(), buckets.data(), count);
+  for (size_t i = 0; i < count; ++i) {
+    s21::Date date = s21::Date::fromSerial(serials[i]);
+    ASSERT_EQ(days[i], date.getDay());
+    ASSERT_EQ(months[i], date.getMonth());
+    ASSERT_EQ(years[i], date.getYear());
+    ASSERT_EQ(back[i], serials[i]);
+    ASSERT_EQ(buckets[i], s21::Date::monthBucket(months[i], years[i]));
+  }
+  EXPECT_EQ(serials[0], 0);
+  EXPECT_EQ(s21::Date::fromSerial(serials[count - 1]), last);
+
+  /* The lowest serial of batch is 1.3.0000, the day after 29.02.0000. */
+  int low = s21::Date::MIN_BATCH_SERIAL, day = 0, month = 0, year = -1;
+  s21::Date::toCivil(&low, &day, &month, &year, 1);
+  EXPECT_EQ(day, 1);
+  EXPECT_EQ(month, 3);
+  EXPECT_EQ(year, 0);
+  s21::Date::fromCivil(&day, &month, &year, &low, 1);
+  EXPECT_EQ(low, s21::Date::MIN_BATCH_SERIAL);
+}
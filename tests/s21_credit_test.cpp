@@ -359,3 +359,33 @@ TEST(CreditSuite, ReturnValues) {
   instance.SetCredit(100000000000.0);
   EXPECT_EQ(instance.Calculate(), true);
 }
+
+TEST(CreditSuite, PaymentDates) {
+  s21::Credit instance;
+  instance.SetTime(3);
+  instance.SetRate(0.1);
+  instance.SetCredit(100000.0);
+  instance.SetStartDate(1, 2024);
+  EXPECT_EQ(instance.GetPaymentDay(), 1);
+  instance.SetPaymentDay(0);
+  EXPECT_FALSE(instance.Calculate());
+  instance.SetPaymentDay(31);
+  EXPECT_TRUE(instance.Calculate());
+  double payment = instance[2].GetPayment();
+  EXPECT_EQ(instance[1].GetDay(), 29);
+  EXPECT_EQ(instance[2].GetDay(), 31);
+
+  instance.SetCalendar(s21::Calendar(), s21::Calendar::A_FOLLOWING);
+  EXPECT_EQ(instance.GetAdjustment(), s21::Calendar::A_FOLLOWING);
+  EXPECT_TRUE(instance.Calculate());
+  EXPECT_EQ(instance[0].GetDay(), 31);
+  EXPECT_EQ(instance[1].GetDay(), 29);
+  EXPECT_EQ(instance[2].GetDay(), 1);
+  EXPECT_EQ(instance[2].GetMonth(), 4);
+  EXPECT_NEAR(instance[2].GetPayment(), payment, EPS);
+
+  instance.SetCalendar(s21::Calendar(), s21::Calendar::A_MODIFIED_FOLLOWING);
+  EXPECT_TRUE(instance.Calculate());
+  EXPECT_EQ(instance[2].GetDay(), 29);
+  EXPECT_EQ(instance[2].GetMonth(), 3);
+}
@@ -0,0 +1,99 @@
+#include "s21_test_main.h"
+
+namespace {
+
+bool Circle(const double* t, double* x, double* y, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    x[i] = std::cos(t[i]);
+    y[i] = std::sin(t[i]);
+  }
+  return true;
+}
+
+/* Straight run for t < 0.5, then ten small loops. */
+bool LineAndLoops(const double* t, double* x, double* y, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    if (t[i] < 0.5) {
+      x[i] = t[i];
+      y[i] = 0.0;
+    } else {
+      double angle = 2 * M_PI * 20 * (t[i] - 0.5);
+      x[i] = 0.5 + 0.05 * std::sin(angle);
+      y[i] = 0.05 - 0.05 * std::cos(angle);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(CurveSamplerSuite, Circle) {
+  s21::CurveSampler::Options options;
+  options.scale_x = options.scale_y = 0.01;
+  s21::CurveSampler sampler(options);
+  std::vector<s21::CurveSampler::Point> points =
+      sampler.Sample(Circle, 0.0, 2 * M_PI);
+  ASSERT_GE(points.size(), 64U);
+  EXPECT_NEAR(points.front().t, 0.0, EPS);
+  EXPECT_NEAR(points.back().t, 2 * M_PI, EPS);
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(std::hypot(points[i].x, points[i].y), 1.0, EPS);
+    if (i > 0) {
+      EXPECT_LT(points[i - 1].t, points[i].t);
+      EXPECT_LE(std::hypot(points[i].x - points[i - 1].x,
+                           points[i].y - points[i - 1].y) /
+                    options.scale_x,
+                options.max_length);
+    }
+  }
+}
+
+TEST(CurveSamplerSuite, LoopsGetMorePoints) {
+  s21::CurveSampler::Options options;
+  options.scale_x = options.scale_y = 0.001;
+  s21::CurveSampler sampler(options);
+  std::vector<s21::CurveSampler::Point> points =
+      sampler.Sample(LineAndLoops, 0.0, 1.0);
+  size_t line = 0, loops = 0;
+  for (const s21::CurveSampler::Point& point : points)
+    (point.t < 0.5 ? line : loops)++;
+  EXPECT_LE(line, 40U);
+  EXPECT_GT(loops, 10 * line);
+  EXPECT_LE(points.size(), options.max_count);
+}
+
+TEST(CurveSamplerSuite, DomainBorder) {
+  s21::CurveSampler sampler;
+  std::vector<s21::CurveSampler::Point> points = sampler.Sample(
+      [](const double* t, double* x, double* y, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          x[i] = t[i];
+          y[i] = std::sqrt(t[i]);
+        }
+        return true;
+      },
+      -1.0, 1.0);
+  double first = 1.0;
+  for (const s21::CurveSampler::Point& point : points)
+    if (std::isfinite(point.y)) first = std::min(first, point.t);
+  EXPECT_LT(first, 1e-3);
+  EXPECT_GE(first, 0.0);
+}
+
+TEST(CurveSamplerSuite, Limits) {
+  s21::CurveSampler::Options options;
+  options.scale_x = options.scale_y = 1e-6;
+  options.max_count = 500;
+  s21::CurveSampler sampler(options);
+  EXPECT_LE(sampler.Sample(Circle, 0.0, 2 * M_PI).size(), 500U);
+  int calls = 0;
+  std::vector<s21::CurveSampler::Point> points = sampler.Sample(
+      [&calls](const double* t, double* x, double* y, size_t count) {
+        calls++;
+        return calls == 1 && Circle(t, x, y, count);
+      },
+      0.0, 2 * M_PI);
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(points.size(), options.initial_count);
+  EXPECT_TRUE(sampler.Sample(Circle, 1.0, 1.0).empty());
+}
@@ -0,0 +1,120 @@
+#include "s21_test_main.h"
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  return ::testing::TempDir() + "s21_dataset_" + name;
+}
+
+}  // namespace
+
+TEST(DatasetSuite, Csv) {
+  const std::string path = TempPath("test.csv");
+  const int rows = 10000;
+  s21::Statistics expected;
+  {
+    std::ofstream file(path);
+    file << "id;value;note\r\n";
+    for (int i = 0; i < rows; ++i) {
+      double x = i * 0.01 - 20;
+      file << i << "; " << x << " ;row\r\n";
+      if (i % 1000 == 0) file << "\n";
+      expected.Add(x * x - 3);
+    }
+    file << rows << ";oops;bad";
+  }
+  s21::Calculation calculation;
+  calculation.SetExpression("x^2 - 3");
+  ASSERT_TRUE(calculation.Compile());
+  s21::Dataset dataset;
+  ASSERT_TRUE(dataset.Open(path, s21::Dataset::CSV, 1, 1, ';'));
+  EXPECT_EQ(dataset.GetStatus(), s21::Dataset::READY);
+  s21::Statistics statistics;
+  ASSERT_TRUE(dataset.Evaluate(calculation, statistics));
+  EXPECT_EQ(statistics.GetCount(), static_cast<size_t>(rows));
+  EXPECT_EQ(statistics.GetNanCount(), 1U);
+  EXPECT_NEAR(statistics.GetMin(), expected.GetMin(), EPS);
+  EXPECT_NEAR(statistics.GetMax(), expected.GetMax(), EPS);
+  EXPECT_NEAR(statistics.GetMean(), expected.GetMean(), 1e-6);
+  EXPECT_NEAR(statistics.GetVariance(), expected.GetVariance(), 1e-3);
+
+  s21::Histogram histogram(statistics.GetMin(), statistics.GetMax(), 10);
+  ASSERT_TRUE(dataset.Evaluate(calculation, histogram));
+  size_t total = 0;
+  for (size_t bin : histogram.GetBins()) total += bin;
+  EXPECT_EQ(total, static_cast<size_t>(rows));
+
+  size_t blocks = 0, count = 0;
+  ASSERT_TRUE(dataset.Evaluate(
+      calculation, [&](const double* x, const double* y, size_t size) {
+        blocks++;
+        for (size_t i = 0; i < size; ++i, ++count) {
+          if (count < static_cast<size_t>(rows)) {
+            ASSERT_NEAR(y[i], x[i] * x[i] - 3, EPS);
+          }
+        }
+      }));
+  EXPECT_EQ(count, static_cast<size_t>(rows) + 1);
+  EXPECT_EQ(blocks, (count + s21::Dataset::BLOCK_SIZE - 1) /
+                        s21::Dataset::BLOCK_SIZE);
+  std::remove(path.c_str());
+}
+
+TEST(DatasetSuite, Binary) {
+  const std::string path = TempPath("test.bin");
+  const int rows = 5000;
+  {
+    std::ofstream file(path, std::ios::binary);
+    for (int i = 0; i < rows; ++i) {
+      double row[3] = {static_cast<double>(i), i * 0.5, -1.0};
+      file.write(reinterpret_cast<const char*>(row), sizeof(row));
+    }
+  }
+  s21::Dataset dataset;
+  ASSERT_TRUE(dataset.Open(path, s21::Dataset::BINARY, 1, 3));
+  s21::Statistics statistics;
+  ASSERT_TRUE(dataset.Read([&statistics](const double* x, const double* y,
+                                         size_t count) {
+    EXPECT_EQ(x, y);
+    statistics.Add(x, count);
+  }));
+  EXPECT_EQ(statistics.GetCount(), static_cast<size_t>(rows));
+  EXPECT_NEAR(statistics.GetMax(), (rows - 1) * 0.5, EPS);
+  EXPECT_FALSE(dataset.Open(path, s21::Dataset::BINARY, 0, 7));
+  EXPECT_EQ(dataset.GetStatus(), s21::Dataset::FORMAT_ERROR);
+  EXPECT_FALSE(dataset.Open(path, s21::Dataset::BINARY, 3, 3));
+  EXPECT_EQ(dataset.GetStatus(), s21::Dataset::FORMAT_ERROR);
+
+  ASSERT_TRUE(dataset.Open(path, s21::Dataset::BINARY));
+  s21::Calculation calculation;
+  calculation.SetExpression("sqrt(x)");
+  ASSERT_TRUE(calculation.Compile());
+  s21::Statistics roots;
+  ASSERT_TRUE(dataset.Evaluate(calculation, roots));
+  EXPECT_EQ(roots.GetCount(), static_cast<size_t>(rows * 2));
+  EXPECT_EQ(roots.GetNanCount(), static_cast<size_t>(rows));
+  std::remove(path.c_str());
+}
+
+TEST(DatasetSuite, Errors) {
+  s21::Dataset dataset;
+  s21::Statistics statistics;
+  s21::Calculation calculation;
+  EXPECT_EQ(dataset.GetStatus(), s21::Dataset::EMPTY);
+  EXPECT_FALSE(dataset.Evaluate(calculation, statistics));
+  EXPECT_FALSE(dataset.Open(TempPath("missing.csv"), s21::Dataset::CSV));
+  EXPECT_EQ(dataset.GetStatus(), s21::Dataset::OPEN_ERROR);
+  const std::string path = TempPath("empty.csv");
+  { std::ofstream file(path); }
+  ASSERT_TRUE(dataset.Open(path, s21::Dataset::CSV));
+  calculation.SetExpression("2 + ");
+  calculation.Compile();
+  EXPECT_FALSE(dataset.Evaluate(calculation, statistics));
+  calculation.SetExpression("x");
+  ASSERT_TRUE(calculation.Compile());
+  EXPECT_TRUE(dataset.Evaluate(calculation, statistics));
+  EXPECT_EQ(statistics.GetCount() + statistics.GetNanCount(), 0U);
+  dataset.Close();
+  EXPECT_EQ(dataset.GetStatus(), s21::Dataset::EMPTY);
+  std::remove(path.c_str());
+}
@@ -356,3 +356,254 @@ TEST(DepositSuite, HugeValues) { /* Examples from calcus.ru */
   s21::TestDeposit::runTestDeposit("tests/deposit_test_hard.txt",
                                    DECIMAL_LOOSE_EPS);
 }
+
+TEST(DepositSuite, ParallelCalculations) {
+  auto calculate = [](s21::Deposit& instance, int index) {
+    instance.setDeposit(100000.0 + index);
+    instance.setTerm(3);
+    instance.setTermType(s21::Deposit::T_YEAR);
+    instance.setStartDate(31, 1, 2020);
+    instance.setInterest(0.07);
+    instance.setTax(0.13);
+    instance.setPeriodicity(s21::Deposit::P_MONTHLY);
+    instance.addReplenish(s21::Deposit::O_MONTHLY, s21::Date(29, 2, 2020),
+                          1000.0);
+    instance.addWithdrawal(s21::Deposit::O_QUARTERLY, s21::Date(31, 3, 2020),
+                           500.0);
+    return instance.calculate();
+  };
+  const size_t count = 64;
+  std::vector<s21::Deposit> expected(count), actual(count);
+  for (size_t i = 0; i < count; ++i)
+    EXPECT_TRUE(calculate(expected[i], static_cast<int>(i)));
+  std::vector<int> done(count, 0);
+  std::vector<s21::Date> today(count);
+  s21::ParallelFor(
+      count,
+      [&](size_t i) {
+        done[i] = calculate(actual[i], static_cast<int>(i));
+        today[i] = s21::Date();
+      },
+      8);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_TRUE(done[i]);
+    EXPECT_TRUE(today[i] >= today[0] - 1 && today[i] <= today[0] + 1);
+    EXPECT_DOUBLE_EQ(actual[i].getBalance(), expected[i].getBalance());
+    EXPECT_DOUBLE_EQ(actual[i].getInterestTotal(),
+                     expected[i].getInterestTotal());
+    ASSERT_EQ(actual[i].getEventListSize(), expected[i].getEventListSize());
+    for (size_t j = 0; j < expected[i].getEventListSize(); ++j) {
+      EXPECT_EQ(actual[i].getEventListElement(j)->date(),
+                expected[i].getEventListElement(j)->date());
+      EXPECT_DOUBLE_EQ(actual[i].getEventListElement(j)->balance(),
+                       expected[i].getEventListElement(j)->balance());
+    }
+  }
+}
+
+TEST(DepositSuite, CalendarDates) {
+  s21::Deposit instance;
+  instance.setDeposit(100000.0);
+  instance.setTerm(6);
+  instance.setTermType(s21::Deposit::T_MONTH);
+  instance.setStartDate(15, 1, 2024);
+  instance.setInterest(0.1);
+  instance.setPeriodicity(s21::Deposit::P_MONTHLY);
+  instance.addReplenish(s21::Deposit::O_ONCE, s21::Date(16, 6, 2024), 1000.0);
+  EXPECT_TRUE(instance.calculate());
+  EXPECT_EQ(instance.getEventListElement(5)->date(), s21::Date(15, 6, 2024));
+  EXPECT_EQ(instance.getEventListElement(6)->date(), s21::Date(16, 6, 2024));
+
+  instance.setCalendar(s21::Calendar(), s21::Calendar::A_FOLLOWING);
+  EXPECT_EQ(instance.getAdjustment(), s21::Calendar::A_FOLLOWING);
+  EXPECT_TRUE(instance.calculate());
+  ASSERT_EQ(instance.getEventListSize(), 8U);
+  EXPECT_EQ(instance.getEventListElement(5)->date(), s21::Date(17, 6, 2024));
+  EXPECT_EQ(instance.getEventListElement(5)->event(),
+            s21::Deposit::E_REPLENISH);
+  EXPECT_EQ(instance.getEventListElement(6)->date(), s21::Date(17, 6, 2024));
+  EXPECT_EQ(instance.getEventListElement(6)->event(), s21::Deposit::E_PAYDAY);
+  EXPECT_EQ(instance.getEventListElement(7)->date(), s21::Date(15, 7, 2024));
+
+  /* Weekend paydays go to Monday and join there, payday moved to the end of
+   * term is left to the last one. End of term 14.01.2024 is not moved. */
+  instance.clearReplenish();
+  instance.setTerm(13);
+  instance.setTermType(s21::Deposit::T_DAY);
+  instance.setStartDate(1, 1, 2024);
+  instance.setPeriodicity(s21::Deposit::P_DAILY);
+  EXPECT_TRUE(instance.calculate());
+  size_t paydays = 0;
+  for (size_t i = 0; i + 1 < instance.getEventListSize(); ++i) {
+    if (instance.getEventListElement(i)->event() != s21::Deposit::E_PAYDAY)
+      continue;
+    EXPECT_NE(instance.getEventListElement(i)->date().getWeekday(), 6);
+    EXPECT_NE(instance.getEventListElement(i)->date().getWeekday(), 7);
+    paydays++;
+  }
+  EXPECT_EQ(paydays, 9U);
+  EXPECT_NEAR(instance.getInterestTotal(), 100000.0 * 0.1 * 13 / 366,
+              DECIMAL_EPS);
+}
+
+/* Operations of one day are spliced into one event, withdrawals win if they
+ * are bigger. */
+TEST(DepositSuite, SplicedOperations) {
+  s21::Deposit instance;
+  instance.setDeposit(100000.0);
+  instance.setTerm(1);
+  instance.setTermType(s21::Deposit::T_YEAR);
+  instance.setStartDate(1, 1, 2024);
+  instance.setPeriodicity(s21::Deposit::P_MONTHLY);
+  for (int i = 0; i < 1000; ++i) {
+    instance.addReplenish(s21::Deposit::O_ONCE, s21::Date(15, 3, 2024), 10.0);
+    instance.addWithdrawal(s21::Deposit::O_ONCE, s21::Date(15, 3, 2024), 11.0);
+    instance.addReplenish(s21::Deposit::O_MONTHLY, s21::Date(1, 2, 2024), 1.0);
+  }
+  EXPECT_TRUE(instance.calculate());
+  /* Deposit, operations of 12 months up to 01.01.2025, one more on 15.03,
+   * 11 paydays, the last one and new year. */
+  ASSERT_EQ(instance.getEventListSize(), 1U + 12 + 1 + 11 + 1 + 1);
+  for (size_t i = 1; i < instance.getEventListSize(); ++i) {
+    s21::Deposit::Event previous = *instance.getEventListElement(i - 1);
+    s21::Deposit::Event current = *instance.getEventListElement(i);
+    EXPECT_TRUE(previous.date() < current.date() ||
+                (previous.date() == current.date() &&
+                 previous.event() < current.event()));
+    if (current.date() == s21::Date(15, 3, 2024)) {
+      EXPECT_EQ(current.event(), s21::Deposit::E_WITHDRAWAL);
+      EXPECT_NEAR(current.balance_change(), -1000.0, EPS);
+    } else if (current.date().getDay() == 1 &&
+               current.event() != s21::Deposit::E_PAYDAY) {
+      EXPECT_EQ(current.event(), s21::Deposit::E_REPLENISH);
+      EXPECT_NEAR(current.balance_change(), 1000.0, EPS);
+    }
+  }
+  EXPECT_NEAR(instance.getBalance(), 100000.0 + 12000.0 - 1000.0, EPS);
+}
+
+/* Summary of deposit without operations is calculated by periods, it must
+ * match simulation of all events. */
+TEST(DepositSuite, SummaryMatchesEvents) {
+  const s21::Date starts[] = {s21::Date(14, 2, 1994), s21::Date(31, 12, 2023),
+                              s21::Date(29, 2, 2024), s21::Date(1, 1, 2025),
+                              s21::Date(31, 1, 2030)};
+  const int terms[][2] = {{s21::Deposit::T_DAY, 1},
+                          {s21::Deposit::T_DAY, 400},
+                          {s21::Deposit::T_MONTH, 13},
+                          {s21::Deposit::T_YEAR, 1},
+                          {s21::Deposit::T_YEAR, 7}};
+  for (const s21::Date& start : starts) {
+    for (const auto& term : terms) {
+      for (int period = s21::Deposit::P_AT_END;
+           period <= s21::Deposit::P_ANNUALLY; ++period) {
+        for (bool capital : {false, true}) {
+          s21::Deposit full;
+          full.setDeposit(123456.78);
+          full.setInterest(0.085);
+          full.setTax(0.13);
+          full.setStartDate(start.getDay(), start.getMonth(), start.getYear());
+          full.setTermType(static_cast<s21::Deposit::TermType>(term[0]));
+          full.setTerm(term[1]);
+          full.setPeriodicity(static_cast<s21::Deposit::PayPeriod>(period));
+          full.setCapitalization(capital);
+          s21::Deposit summary = full;
+          ASSERT_TRUE(full.calculate());
+          ASSERT_TRUE(summary.calculate(s21::Deposit::M_SUMMARY_ONLY));
+          EXPECT_EQ(summary.getEventListSize(), 0U);
+          double eps = 1e-9 * full.getBalance();
+          EXPECT_NEAR(summary.getBalance(), full.getBalance(), eps);
+          EXPECT_NEAR(summary.getInterestTotal(), full.getInterestTotal(),
+                      eps);
+          EXPECT_NEAR(summary.getTaxTotal(), full.getTaxTotal(), eps);
+          ASSERT_EQ(summary.getTaxListSize(), full.getTaxListSize());
+          for (size_t i = 0; i < full.getTaxListSize(); ++i) {
+            EXPECT_EQ(summary.getTaxListElement(i)->year(),
+                      full.getTaxListElement(i)->year());
+            EXPECT_NEAR(summary.getTaxListElement(i)->income(),
+                        full.getTaxListElement(i)->income(), eps);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(DepositSuite, SummaryLongTerm) {
+  s21::Deposit full;
+  full.setDeposit(1000.0);
+  full.setInterest(0.05);
+  full.setTax(0.1);
+  full.setStartDate(1, 3, 2001);
+  full.setTermType(s21::Deposit::T_YEAR);
+  full.setTerm(s21::Deposit::MAX_TERM_Y);
+  full.setPeriodicity(s21::Deposit::P_DAILY);
+  full.setCapitalization(true);
+  s21::Deposit summary = full;
+  ASSERT_TRUE(full.calculate());
+  ASSERT_TRUE(summary.calculate(s21::Deposit::M_SUMMARY_ONLY));
+  EXPECT_GT(full.getEventListSize(), 364000U);
+  EXPECT_NEAR(summary.getBalance() / full.getBalance(), 1.0, 1e-9);
+  EXPECT_NEAR(summary.getTaxTotal() / full.getTaxTotal(), 1.0, 1e-9);
+  EXPECT_EQ(summary.getTaxListSize(), full.getTaxListSize());
+}
+
+/* Deposit with operations is counted by the same steps in both modes, only
+ * events are not stored. Gains between paydays are summed in other order,
+ * so values may differ by rounding. */
+TEST(DepositSuite, SummaryStreamsEvents) {
+  s21::Calendar calendar;
+  calendar.addAnnualHoliday(1, 1, s21::Calendar::OB_NEXT_WEEKDAY);
+  for (int adjustment = s21::Calendar::A_NONE;
+       adjustment <= s21::Calendar::A_MODIFIED_FOLLOWING; ++adjustment) {
+    s21::Deposit full;
+    full.setDeposit(50000.0);
+    full.setInterest(0.12);
+    full.setTax(0.13);
+    full.setStartDate(31, 1, 2023);
+    full.setTermType(s21::Deposit::T_MONTH);
+    full.setTerm(40);
+    full.setPeriodicity(s21::Deposit::P_WEEKLY);
+    full.setCapitalization(true);
+    full.setRemainderLimit(45000.0);
+    full.addReplenish(s21::Deposit::O_MONTHLY, s21::Date(31, 1, 2023), 700.0);
+    full.addWithdrawal(s21::Deposit::O_QUARTERLY, s21::Date(28, 2, 2023),
+                       3000.0);
+    full.addWithdrawal(s21::Deposit::O_ONCE, s21::Date(1, 6, 2024), 1e6);
+    full.setCalendar(calendar,
+                     static_cast<s21::Calendar::Adjustment>(adjustment));
+    s21::Deposit summary = full;
+    ASSERT_TRUE(full.calculate(s21::Deposit::M_FULL));
+    ASSERT_TRUE(summary.calculate(s21::Deposit::M_SUMMARY_ONLY));
+    EXPECT_GT(full.getEventListSize(), 200U);
+    EXPECT_EQ(summary.getEventListSize(), 0U);
+    double eps = 1e-12 * full.getBalance();
+    EXPECT_NEAR(summary.getBalance(), full.getBalance(), eps);
+    EXPECT_NEAR(summary.getInterestTotal(), full.getInterestTotal(), eps);
+    EXPECT_NEAR(summary.getTaxTotal(), full.getTaxTotal(), eps);
+    EXPECT_EQ(summary.getReplenishTotal(), full.getReplenishTotal());
+    EXPECT_EQ(summary.getWithdrawalTotal(), full.getWithdrawalTotal());
+    ASSERT_EQ(summary.getTaxListSize(), full.getTaxListSize());
+    for (size_t i = 0; i < full.getTaxListSize(); ++i)
+      EXPECT_NEAR(summary.getTaxListElement(i)->tax(),
+                  full.getTaxListElement(i)->tax(), eps);
+  }
+
+  /* Daily paydays with operations are not applied by periods either. */
+  s21::Deposit full;
+  full.setDeposit(1000.0);
+  full.setInterest(0.05);
+  full.setStartDate(1, 3, 2001);
+  full.setTermType(s21::Deposit::T_YEAR);
+  full.setTerm(10);
+  full.setPeriodicity(s21::Deposit::P_DAILY);
+  full.setCapitalization(true);
+  full.addReplenish(s21::Deposit::O_ANNUALLY, s21::Date(1, 6, 2001), 100.0);
+  s21::Deposit summary = full;
+  ASSERT_TRUE(full.calculate());
+  ASSERT_TRUE(summary.calculate(s21::Deposit::M_SUMMARY_ONLY));
+  EXPECT_EQ(summary.getEventListSize(), 0U);
+  EXPECT_NEAR(summary.getBalance(), full.getBalance(),
+              1e-12 * full.getBalance());
+  EXPECT_EQ(summary.getReplenishTotal(), full.getReplenishTotal());
+}
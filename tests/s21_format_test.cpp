@@ -0,0 +1,79 @@
+#include "s21_test_main.h"
+
+#include <cstdio>
+#include <random>
+
+namespace {
+
+std::string Shortest(double value) {
+  char buffer[s21::Format::BUFFER_SIZE];
+  return std::string(buffer, s21::Format::Shortest(buffer, value));
+}
+
+std::string Money(double value, bool trim = false) {
+  char buffer[s21::Format::BUFFER_SIZE];
+  return std::string(buffer, s21::Format::Money(buffer, value, trim));
+}
+
+}  // namespace
+
+TEST(FormatSuite, Shortest) {
+  EXPECT_EQ(Shortest(0.1), "0.1");
+  EXPECT_EQ(Shortest(0.1 + 0.2), "0.30000000000000004");
+  EXPECT_EQ(Shortest(-2.5e-300), "-2.5e-300");
+  EXPECT_EQ(Shortest(1e21), "1e+21");
+  EXPECT_EQ(Shortest(0.0), "0");
+  EXPECT_EQ(Shortest(-NAN), "nan");
+  EXPECT_EQ(Shortest(-INFINITY), "-inf");
+  std::mt19937_64 random(42);
+  for (int i = 0; i < 10000; ++i) {
+    double value;
+    unsigned long long bits = random();
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value) == false) continue;
+    std::string text = Shortest(value);
+    EXPECT_LE(text.size(), s21::Format::BUFFER_SIZE);
+    EXPECT_EQ(std::strtod(text.c_str(), nullptr), value);
+  }
+}
+
+/* Precise form is the same as printf gives. */
+TEST(FormatSuite, Precise) {
+  for (double value : {1.0 / 3, 2.0 / 3 * 1e16, 1e16, 123456.0, 1e-5,
+                       -0.000123, 1e300, 5e-324, -1.7976931348623157e308}) {
+    char expected[64];
+    std::snprintf(expected, sizeof(expected), "%.16g", value);
+    EXPECT_EQ(s21::Format::ToString(value), expected);
+    std::snprintf(expected, sizeof(expected), "%.3g", value);
+    EXPECT_EQ(s21::Format::ToString(value, 3), expected);
+  }
+  EXPECT_EQ(s21::Format::ToString(0.1 + 0.2), "0.3");
+  EXPECT_EQ(s21::Format::ToString(INFINITY), "inf");
+
+  /* Precision beyond what double holds gives all of its digits. */
+  char buffer[s21::Format::BUFFER_SIZE];
+  s21::Format::Precise(buffer, -1.2345678901234568e-300, 25);
+  for (int precision : {18, 25, 30, 1000}) {
+    EXPECT_EQ(std::string(buffer, s21::Format::Precise(buffer, -0.1,
+                                                       precision)),
+              "-0.10000000000000001");
+    EXPECT_EQ(s21::Format::ToString(-1.2345678901234568e-300, precision),
+              "-1.2345678901234568e-300");
+  }
+  EXPECT_EQ(s21::Format::ToString(123.0, 0), "1e+02");
+  EXPECT_EQ(s21::Format::ToString(123.0, -5), "1e+02");
+}
+
+TEST(FormatSuite, Money) {
+  EXPECT_EQ(Money(1234.5), "1234.50");
+  EXPECT_EQ(Money(1234.5, true), "1234.5");
+  EXPECT_EQ(Money(100.0, true), "100");
+  EXPECT_EQ(Money(0.125), "0.12");
+  EXPECT_EQ(Money(-0.004), "0.00");
+  EXPECT_EQ(Money(-0.004, true), "0");
+  EXPECT_EQ(Money(-0.006), "-0.01");
+  EXPECT_EQ(Money(-12.0, true), "-12");
+  EXPECT_EQ(Money(99999999999999984.0), "99999999999999984.00");
+  EXPECT_EQ(Money(-2.5e20), "-2.5e+20");
+  EXPECT_EQ(Money(NAN), "nan");
+}
@@ -0,0 +1,97 @@
+#include "s21_test_main.h"
+
+namespace {
+
+double TotalLength(const std::vector<s21::ImplicitCurve::Segment>& segments) {
+  double length = 0.0;
+  for (const s21::ImplicitCurve::Segment& segment : segments)
+    length += std::hypot(segment.x2 - segment.x1, segment.y2 - segment.y1);
+  return length;
+}
+
+}  // namespace
+
+TEST(ImplicitCurveSuite, Circle) {
+  std::atomic<size_t> points{0};
+  s21::ImplicitCurve curve;
+  std::vector<s21::ImplicitCurve::Segment> segments;
+  ASSERT_TRUE(curve.Trace(
+      [&points](const double* x, const double* y, double* z, size_t count) {
+        points += count;
+        for (size_t i = 0; i < count; ++i) z[i] = x[i] * x[i] + y[i] * y[i] - 1;
+        return true;
+      },
+      -2.0, 2.0, -2.0, 2.0, segments));
+  ASSERT_FALSE(segments.empty());
+  for (const s21::ImplicitCurve::Segment& segment : segments) {
+    EXPECT_NEAR(std::hypot(segment.x1, segment.y1), 1.0, 1e-4);
+    EXPECT_NEAR(std::hypot(segment.x2, segment.y2), 1.0, 1e-4);
+  }
+  EXPECT_NEAR(TotalLength(segments), 2 * M_PI, 1e-3);
+  /* Uniform grid of the same resolution has 1025 x 1025 points. */
+  EXPECT_LT(points.load(), 1025U * 1025U / 20);
+}
+
+TEST(ImplicitCurveSuite, Saddle) {
+  s21::ImplicitCurve::Options options;
+  options.cells_x = options.cells_y = 7;
+  options.max_depth = 0;
+  s21::ImplicitCurve curve(options);
+  std::vector<s21::ImplicitCurve::Segment> segments;
+  ASSERT_TRUE(curve.Trace(
+      [](const double* x, const double* y, double* z, size_t count) {
+        for (size_t i = 0; i < count; ++i) z[i] = x[i] * y[i];
+        return true;
+      },
+      -1.0, 1.0, -1.0, 1.0, segments));
+  for (const s21::ImplicitCurve::Segment& segment : segments) {
+    EXPECT_TRUE(std::fabs(segment.x1) < EPS || std::fabs(segment.y1) < EPS);
+    EXPECT_TRUE(std::fabs(segment.x2) < EPS || std::fabs(segment.y2) < EPS);
+  }
+  /* Saddle cell in the center is cut into two corners. */
+  EXPECT_EQ(segments.size(), 14U);
+  EXPECT_NEAR(TotalLength(segments), 12 * 2.0 / 7 + 2 * std::sqrt(2.0) / 7,
+              EPS);
+}
+
+TEST(ImplicitCurveSuite, Undefined) {
+  s21::ImplicitCurve curve;
+  std::vector<s21::ImplicitCurve::Segment> segments;
+  ASSERT_TRUE(curve.Trace(
+      [](const double*, const double*, double* z, size_t count) {
+        std::fill(z, z + count, NAN);
+        return true;
+      },
+      -1.0, 1.0, -1.0, 1.0, segments));
+  EXPECT_TRUE(segments.empty());
+  ASSERT_TRUE(curve.Trace(
+      [](const double*, const double*, double* z, size_t count) {
+        std::fill(z, z + count, 1.0);
+        return true;
+      },
+      1.0, -1.0, -1.0, 1.0, segments));
+  EXPECT_TRUE(segments.empty());
+}
+
+TEST(ImplicitCurveSuite, Stop) {
+  s21::ImplicitCurve curve;
+  std::vector<s21::ImplicitCurve::Segment> segments;
+  std::atomic<int> calls{0};
+  EXPECT_FALSE(curve.Trace(
+      [&calls](const double* x, const double*, double* z, size_t count) {
+        std::copy(x, x + count, z);
+        return ++calls == 1;
+      },
+      -1.0, 1.0, -1.0, 1.0, segments));
+}
+
+TEST(ImplicitCurveSuite, ToZeroForm) {
+  EXPECT_EQ(s21::ImplicitCurve::ToZeroForm("x^2 + y^2 = 1"),
+            "(x^2 + y^2 )-( 1)");
+  EXPECT_EQ(s21::ImplicitCurve::ToZeroForm("sin(x) - y"), "sin(x) - y");
+  s21::Calculation instance;
+  instance.SetY(2.0);
+  EXPECT_NEAR(
+      instance.GetResult(s21::ImplicitCurve::ToZeroForm("x*y = 2+x"), 3.0),
+      1.0, EPS);
+}
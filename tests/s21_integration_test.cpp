@@ -0,0 +1,100 @@
+#include "s21_test_main.h"
+
+namespace {
+
+s21::Integration::Result Integrate(const std::string& expression, double a,
+                                   double b, unsigned threads = 0) {
+  s21::Calculation calculation;
+  calculation.SetExpression(expression);
+  EXPECT_TRUE(calculation.Compile());
+  s21::Integration::Options options;
+  options.threads = threads;
+  s21::Integration::Result result;
+  EXPECT_TRUE(s21::Integration(options).Integrate(calculation, a, b, result));
+  return result;
+}
+
+}  // namespace
+
+TEST(IntegrationSuite, SmoothFunctions) {
+  s21::Integration::Result result = Integrate("x^2", 0.0, 3.0);
+  EXPECT_TRUE(result.converged);
+  EXPECT_NEAR(result.value, 9.0, 1e-12);
+  result = Integrate("sin(x)", 0.0, M_PI);
+  EXPECT_TRUE(result.converged);
+  EXPECT_NEAR(result.value, 2.0, 1e-10);
+  EXPECT_LE(result.error, 1e-9);
+  result = Integrate("ln(x)", 1.0, M_E);
+  EXPECT_NEAR(result.value, 1.0, 1e-10);
+  result = Integrate("sin(x)", M_PI, 0.0);
+  EXPECT_NEAR(result.value, -2.0, 1e-10);
+  result = Integrate("cos(x)", 5.0, 5.0);
+  EXPECT_TRUE(result.converged);
+  EXPECT_EQ(result.value, 0.0);
+}
+
+TEST(IntegrationSuite, Singularities) {
+  s21::Integration::Result result = Integrate("sqrt(x)", 0.0, 1.0);
+  EXPECT_TRUE(result.converged);
+  EXPECT_NEAR(result.value, 2.0 / 3.0, 1e-9);
+  result = Integrate("1/sqrt(x)", 0.0, 1.0);
+  EXPECT_NEAR(result.value, 2.0, 1e-6);
+  EXPECT_GT(result.segments, 4U);
+  result = Integrate("sqrt(x)", -1.0, 1.0);
+  EXPECT_FALSE(result.converged);
+  EXPECT_TRUE(std::isnan(result.value));
+}
+
+/* Segments are summed in order, so result is the same for any number of
+ * threads. */
+TEST(IntegrationSuite, Threads) {
+  s21::Integration::Result single = Integrate("sin(1/x)", 0.01, 2.0, 1);
+  for (unsigned threads : {2U, 8U}) {
+    s21::Integration::Options options;
+    options.threads = threads;
+    options.initial_segments = 4;
+    s21::Calculation calculation;
+    calculation.SetExpression("sin(1/x)");
+    ASSERT_TRUE(calculation.Compile());
+    s21::Integration::Result result;
+    ASSERT_TRUE(
+        s21::Integration(options).Integrate(calculation, 0.01, 2.0, result));
+    options.threads = 1;
+    s21::Integration::Result expected;
+    ASSERT_TRUE(s21::Integration(options).Integrate(calculation, 0.01, 2.0,
+                                                    expected));
+    EXPECT_EQ(result.value, expected.value);
+    EXPECT_EQ(result.segments, expected.segments);
+    EXPECT_NEAR(result.value, single.value, 1e-9);
+  }
+}
+
+TEST(IntegrationSuite, Invalid) {
+  s21::Calculation calculation;
+  s21::Integration integration;
+  s21::Integration::Result result;
+  EXPECT_FALSE(integration.Integrate(calculation, 0.0, 1.0, result));
+  calculation.SetExpression("2 + )");
+  calculation.Compile();
+  EXPECT_FALSE(integration.Integrate(calculation, 0.0, 1.0, result));
+  EXPECT_TRUE(std::isnan(result.value));
+}
+
+TEST(IntegrationSuite, Stop) {
+  s21::Calculation calculation;
+  calculation.SetExpression("sin(1/x)");
+  ASSERT_TRUE(calculation.Compile());
+  s21::Integration::Options options;
+  options.threads = 4;
+  s21::Integration integration(options);
+  s21::Integration::Result expected, result;
+  ASSERT_TRUE(integration.Integrate(calculation, 0.001, 2.0, expected));
+  std::atomic<size_t> calls{0};
+  EXPECT_FALSE(integration.Integrate(calculation, 0.001, 2.0, result,
+                                     [&calls]() { return ++calls < 40; }));
+  EXPECT_LT(calls.load(), expected.segments / 2);
+  ASSERT_TRUE(integration.Integrate(calculation, 0.001, 2.0, result,
+                                    []() { return true; }));
+  EXPECT_EQ(result.value, expected.value);
+  EXPECT_EQ(result.segments, expected.segments);
+}
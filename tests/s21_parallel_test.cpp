@@ -0,0 +1,50 @@
+#include "s21_test_main.h"
+
+TEST(ParallelSuite, EveryIndexOnce) {
+  const size_t count = 10000;
+  std::vector<std::atomic<int>> visits(count);
+  s21::ParallelFor(count, [&visits](size_t i) { visits[i]++; }, 4);
+  for (size_t i = 0; i < count; ++i) EXPECT_EQ(visits[i].load(), 1);
+}
+
+TEST(ParallelSuite, SmallCounts) {
+  int calls = 0;
+  s21::ParallelFor(0, [&calls](size_t) { calls++; });
+  EXPECT_EQ(calls, 0);
+  s21::ParallelFor(1, [&calls](size_t) { calls++; }, 8);
+  EXPECT_EQ(calls, 1);
+  std::vector<int> values(100, 0);
+  s21::ParallelFor(values.size(), [&values](size_t i) { values[i] = i; }, 1);
+  for (size_t i = 0; i < values.size(); ++i)
+    EXPECT_EQ(values[i], static_cast<int>(i));
+  EXPECT_GE(s21::HardwareThreads(), 1U);
+}
+
+/* Every task of size above 1 spawns two halves, so sizes of leaf tasks sum
+ * up to the initial ones. */
+TEST(ParallelSuite, SpawnedTasks) {
+  for (unsigned threads : {1U, 2U, 8U}) {
+    std::vector<std::atomic<int>> leaves(threads);
+    std::atomic<int> total{0};
+    s21::ParallelTasks(
+        std::vector<int>{1000, 1, 37},
+        [&](int task, auto& spawn, unsigned thread) {
+          if (task > 1) {
+            spawn(task / 2);
+            spawn(task - task / 2);
+            return;
+          }
+          leaves[thread]++;
+          total += task;
+        },
+        threads);
+    EXPECT_EQ(total.load(), 1038);
+    int sum = 0;
+    for (std::atomic<int>& count : leaves) sum += count;
+    EXPECT_EQ(sum, 1038);
+  }
+  int calls = 0;
+  s21::ParallelTasks(
+      std::vector<int>{}, [&calls](int, auto&, unsigned) { calls++; }, 4);
+  EXPECT_EQ(calls, 0);
+}
@@ -0,0 +1,97 @@
+#include "s21_test_main.h"
+
+namespace {
+
+/* Straightforward sequential reduction to compare with. */
+s21::Reduction::Result Naive(s21::Calculation& calculation, double min_x,
+                             double max_x, unsigned long long samples) {
+  s21::Reduction::Result result;
+  double step = (max_x - min_x) / (samples - 1);
+  int last_sign = 0;
+  for (unsigned long long i = 0; i < samples; ++i) {
+    double x = i + 1 == samples ? max_x : min_x + i * step;
+    double y = calculation.GetResult(x);
+    if (!std::isfinite(y)) {
+      result.nan_count++;
+      continue;
+    }
+    if (result.count == 0 || y < result.min) {
+      result.min = y;
+      result.arg_min = x;
+    }
+    if (result.count == 0 || y > result.max) {
+      result.max = y;
+      result.arg_max = x;
+    }
+    result.count++;
+    result.sum += y;
+    int sign = (y > 0) - (y < 0);
+    if (sign != 0 && last_sign != 0 && sign != last_sign)
+      result.sign_changes++;
+    if (sign != 0) last_sign = sign;
+  }
+  result.mean = result.sum / result.count;
+  return result;
+}
+
+void Compare(const std::string& expression, double min_x, double max_x,
+             unsigned long long samples) {
+  s21::Calculation calculation;
+  calculation.SetExpression(expression);
+  ASSERT_TRUE(calculation.Compile());
+  s21::Reduction::Result expected = Naive(calculation, min_x, max_x, samples);
+  for (unsigned threads : {1U, 3U, 8U}) {
+    s21::Reduction::Result result;
+    ASSERT_TRUE(s21::Reduction::Reduce(calculation, min_x, max_x, samples,
+                                       result, threads));
+    EXPECT_EQ(result.count, expected.count);
+    EXPECT_EQ(result.nan_count, expected.nan_count);
+    EXPECT_EQ(result.sign_changes, expected.sign_changes);
+    EXPECT_NEAR(result.min, expected.min, EPS);
+    EXPECT_NEAR(result.max, expected.max, EPS);
+    EXPECT_NEAR(result.arg_min, expected.arg_min, EPS);
+    EXPECT_NEAR(result.arg_max, expected.arg_max, EPS);
+    EXPECT_NEAR(result.sum, expected.sum, 1e-6);
+    EXPECT_NEAR(result.mean, expected.mean, EPS);
+  }
+}
+
+}  // namespace
+
+TEST(ReductionSuite, Sine) {
+  Compare("sin(x)", 0.0, 100.0, 100001);
+  s21::Calculation calculation;
+  calculation.SetExpression("sin(x)");
+  ASSERT_TRUE(calculation.Compile());
+  s21::Reduction::Result result;
+  ASSERT_TRUE(
+      s21::Reduction::Reduce(calculation, 0.5, 100.0, 1000000, result));
+  EXPECT_EQ(result.sign_changes, 31U);
+  EXPECT_NEAR(result.max, 1.0, 1e-9);
+  EXPECT_NEAR(std::sin(result.arg_max), 1.0, 1e-9);
+}
+
+TEST(ReductionSuite, DomainErrors) {
+  Compare("sqrt(x) - 1", -3.0, 3.0, 12345);
+  Compare("1/x", -1.0, 1.0, 20001);
+  Compare("tan(x)", -10.0, 10.0, 50000);
+}
+
+TEST(ReductionSuite, SmallCounts) {
+  s21::Calculation calculation;
+  calculation.SetExpression("x^2");
+  ASSERT_TRUE(calculation.Compile());
+  s21::Reduction::Result result;
+  ASSERT_TRUE(s21::Reduction::Reduce(calculation, 3.0, 5.0, 0, result));
+  EXPECT_EQ(result.count, 0U);
+  EXPECT_TRUE(std::isnan(result.mean));
+  ASSERT_TRUE(s21::Reduction::Reduce(calculation, 3.0, 5.0, 1, result));
+  EXPECT_EQ(result.count, 1U);
+  EXPECT_NEAR(result.sum, 9.0, EPS);
+  ASSERT_TRUE(s21::Reduction::Reduce(calculation, 3.0, 5.0, 2, result));
+  EXPECT_NEAR(result.arg_max, 5.0, EPS);
+  EXPECT_NEAR(result.mean, 17.0, EPS);
+  calculation.SetExpression("2 +");
+  calculation.Compile();
+  EXPECT_FALSE(s21::Reduction::Reduce(calculation, 3.0, 5.0, 10, result));
+}
@@ -0,0 +1,49 @@
+#include <thread>
+
+#include "s21_test_main.h"
+
+TEST(RingBufferSuite, SingleThread) {
+  s21::RingBuffer<int, 4> buffer;
+  int value = 0;
+  EXPECT_EQ(buffer.capacity(), 4U);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_FALSE(buffer.pop(value));
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(buffer.push(i));
+  EXPECT_FALSE(buffer.push(4));
+  EXPECT_EQ(buffer.size(), 4U);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_TRUE(buffer.push(4));
+  EXPECT_TRUE(buffer.push(5));
+  EXPECT_TRUE(buffer.push(6));
+  for (int i = 3; i < 7; ++i) {
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(buffer.pop(value));
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferSuite, ProducerConsumer) {
+  const long long count = 1000000;
+  s21::RingBuffer<long long, 1024> buffer;
+  std::thread producer([&buffer, count]() {
+    for (long long i = 0; i < count; ++i)
+      while (!buffer.push(i)) std::this_thread::yield();
+  });
+  long long expected = 0, value = 0;
+  bool ordered = true;
+  while (expected < count) {
+    if (buffer.pop(value)) {
+      if (value != expected) ordered = false;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(buffer.empty());
+}
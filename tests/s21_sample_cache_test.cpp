@@ -0,0 +1,134 @@
+#include "s21_test_main.h"
+
+namespace {
+
+double Square(double x) { return x * x; }
+
+}  // namespace
+
+TEST(SampleCacheSuite, MakeGrid) {
+  s21::SampleCache::Grid grid = s21::SampleCache::MakeGrid(-10.0, 10.0, 400);
+  EXPECT_EQ(grid.level, -4);
+  EXPECT_EQ(grid.first, -160);
+  EXPECT_EQ(grid.count, 321);
+  EXPECT_NEAR(s21::SampleCache::Position(grid.level, grid.first), -10.0, EPS);
+  grid = s21::SampleCache::MakeGrid(-10.0, 10.0, 600);
+  EXPECT_EQ(grid.level, -5);
+  EXPECT_EQ(grid.count, 641);
+  grid = s21::SampleCache::MakeGrid(0.3, 0.7, 4);
+  EXPECT_EQ(grid.level, -3);
+  EXPECT_EQ(grid.first, 3);
+  EXPECT_EQ(grid.count, 3);
+  grid = s21::SampleCache::MakeGrid(1.0, 1.0, 400);
+  EXPECT_EQ(grid.count, 0);
+  grid = s21::SampleCache::MakeGrid(0.0, 1.0, 0);
+  EXPECT_EQ(grid.count, 0);
+}
+
+TEST(SampleCacheSuite, Pan) {
+  s21::SampleCache cache;
+  int evaluations = 0;
+  auto evaluate = [&evaluations](double x) {
+    evaluations++;
+    return Square(x);
+  };
+  cache.SetFunction("x^2", false);
+  for (long long i = -100; i < 100; ++i)
+    EXPECT_NEAR(cache.Get(-3, i, evaluate),
+                Square(s21::SampleCache::Position(-3, i)), EPS);
+  EXPECT_EQ(evaluations, 200);
+  evaluations = 0;
+  for (long long i = -90; i < 110; ++i) cache.Get(-3, i, evaluate);
+  EXPECT_EQ(evaluations, 10);
+}
+
+TEST(SampleCacheSuite, Zoom) {
+  s21::SampleCache cache;
+  int evaluations = 0;
+  auto evaluate = [&evaluations](double x) {
+    evaluations++;
+    return Square(x);
+  };
+  cache.SetFunction("x^2", false);
+  for (long long i = 0; i < 128; ++i) cache.Get(0, i, evaluate);
+  evaluations = 0;
+  /* Zoom in: every second point is known from coarser level. */
+  for (long long i = 0; i < 256; ++i)
+    EXPECT_NEAR(cache.Get(-1, i, evaluate),
+                Square(s21::SampleCache::Position(-1, i)), EPS);
+  EXPECT_EQ(evaluations, 128);
+  evaluations = 0;
+  /* Zoom out: all points are known from finer levels. */
+  for (long long i = 0; i < 64; ++i) cache.Get(1, i, evaluate);
+  EXPECT_EQ(evaluations, 0);
+  double value = 0.0;
+  EXPECT_FALSE(cache.Find(1, 64, value));
+  EXPECT_TRUE(cache.Find(2, 31, value));
+  EXPECT_NEAR(value, Square(124.0), EPS);
+}
+
+TEST(SampleCacheSuite, Functions) {
+  s21::SampleCache cache;
+  double value = 0.0;
+  cache.SetFunction("sin(x)", false);
+  cache.Store(0, -1, 1.0);
+  EXPECT_TRUE(cache.Find(0, -1, value));
+  EXPECT_EQ(value, 1.0);
+  EXPECT_FALSE(cache.Find(0, 63, value));
+  cache.SetFunction("sin(x)", true);
+  EXPECT_FALSE(cache.Find(0, -1, value));
+  cache.Store(0, -1, 2.0);
+  cache.SetFunction("sin(x)", false);
+  EXPECT_TRUE(cache.Find(0, -1, value));
+  EXPECT_EQ(value, 1.0);
+  EXPECT_EQ(cache.Size(), 2U);
+  cache.Clear();
+  EXPECT_FALSE(cache.Find(0, -1, value));
+  EXPECT_EQ(cache.Size(), 0U);
+}
+
+TEST(SampleCacheSuite, Eviction) {
+  s21::SampleCache cache(2);
+  double value = 0.0;
+  cache.SetFunction("x", false);
+  cache.Store(0, 0, 0.0);
+  cache.Store(0, 64, 64.0);
+  EXPECT_TRUE(cache.Find(0, 0, value));
+  cache.Store(0, 128, 128.0);
+  EXPECT_EQ(cache.Size(), 2U);
+  EXPECT_TRUE(cache.Find(0, 0, value));
+  EXPECT_FALSE(cache.Find(0, 64, value));
+  EXPECT_TRUE(cache.Find(0, 128, value));
+}
+
+TEST(SampleCacheSuite, FunctionIds) {
+  s21::SampleCache::FunctionIds ids;
+  int first = ids.Select("x", false);
+  ids.AddTile(first);
+  EXPECT_EQ(ids.Select("x", false), first);
+  EXPECT_NE(ids.Select("x", true), first);
+  for (int i = 0; i < 100; ++i) ids.Select("x+" + std::to_string(i), false);
+  EXPECT_EQ(ids.Size(), 2U);
+  EXPECT_EQ(ids.Select("x", false), first);
+  ids.RemoveTile(first);
+  int second = ids.Select("x^2", false);
+  EXPECT_EQ(ids.Size(), 1U);
+  EXPECT_NE(ids.Select("x", false), first);
+  EXPECT_NE(ids.Select("x^2", false), second);
+  ids.Clear();
+  EXPECT_EQ(ids.Size(), 0U);
+}
+
+TEST(SampleCacheSuite, EvictedFunctions) {
+  s21::SampleCache cache(2);
+  double value = 0.0;
+  for (int i = 0; i < 100; ++i) {
+    cache.SetFunction(std::to_string(i) + "*x", false);
+    cache.Store(0, 0, i);
+  }
+  cache.SetFunction("98*x", false);
+  EXPECT_TRUE(cache.Find(0, 0, value));
+  EXPECT_EQ(value, 98.0);
+  cache.SetFunction("97*x", false);
+  EXPECT_FALSE(cache.Find(0, 0, value));
+}
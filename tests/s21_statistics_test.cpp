@@ -0,0 +1,54 @@
+#include "s21_test_main.h"
+
+TEST(StatisticsSuite, Aggregates) {
+  s21::Statistics statistics;
+  EXPECT_TRUE(std::isnan(statistics.GetMean()));
+  EXPECT_TRUE(std::isnan(statistics.GetMin()));
+  const double values[] = {4.0, -2.0, NAN, 7.5, INFINITY, 0.5};
+  statistics.Add(values, 6);
+  EXPECT_EQ(statistics.GetCount(), 4U);
+  EXPECT_EQ(statistics.GetNanCount(), 2U);
+  EXPECT_NEAR(statistics.GetMin(), -2.0, EPS);
+  EXPECT_NEAR(statistics.GetMax(), 7.5, EPS);
+  EXPECT_NEAR(statistics.GetMean(), 2.5, EPS);
+  EXPECT_NEAR(statistics.GetVariance(), 12.875, EPS);
+}
+
+TEST(StatisticsSuite, Merge) {
+  s21::Statistics whole, first, second, empty;
+  for (int i = 0; i < 1000; ++i) {
+    double value = std::sin(i) * 100 + 1e6;
+    whole.Add(value);
+    (i < 300 ? first : second).Add(value);
+  }
+  first.Add(NAN);
+  first.Merge(second);
+  first.Merge(empty);
+  EXPECT_EQ(first.GetCount(), whole.GetCount());
+  EXPECT_EQ(first.GetNanCount(), 1U);
+  EXPECT_NEAR(first.GetMean(), whole.GetMean(), EPS);
+  EXPECT_NEAR(first.GetVariance(), whole.GetVariance(), 1e-6);
+  EXPECT_NEAR(first.GetMin(), whole.GetMin(), EPS);
+  EXPECT_NEAR(first.GetMax(), whole.GetMax(), EPS);
+  empty.Add(NAN);
+  empty.Merge(whole);
+  EXPECT_EQ(empty.GetNanCount(), 1U);
+  EXPECT_NEAR(empty.GetMean(), whole.GetMean(), EPS);
+}
+
+TEST(StatisticsSuite, Histogram) {
+  s21::Histogram histogram(0.0, 10.0, 5);
+  const double values[] = {-1.0, 0.0, 1.9, 2.0, 5.5, 9.99, 10.0, 10.5, NAN};
+  histogram.Add(values, 9);
+  std::vector<size_t> expected = {2, 1, 1, 0, 2};
+  EXPECT_EQ(histogram.GetBins(), expected);
+  EXPECT_EQ(histogram.GetUnderflow(), 1U);
+  EXPECT_EQ(histogram.GetOverflow(), 1U);
+  s21::Histogram other(0.0, 10.0, 5);
+  other.Add(3.0);
+  histogram.Merge(other);
+  EXPECT_EQ(histogram.GetBins()[1], 2U);
+  s21::Histogram point(1.0, 1.0, 3);
+  point.Add(1.0);
+  EXPECT_EQ(point.GetBins()[0], 1U);
+}
@@ -0,0 +1,120 @@
+#include "s21_test_main.h"
+
+namespace {
+
+double Surface(double x, double y) { return x * x - 3 * y; }
+
+}  // namespace
+
+class SurfaceCacheSuite : public ::testing::Test {
+ protected:
+  std::atomic<int> tiles{0};
+  s21::SurfaceCache::Evaluator evaluate = [this](const double* x,
+                                                 const double* y, double* z,
+                                                 size_t count) {
+    tiles++;
+    for (size_t i = 0; i < count; ++i) z[i] = Surface(x[i], y[i]);
+    return true;
+  };
+
+  static void Check(const s21::SurfaceCache::Grid& grid,
+                    const std::vector<double>& values) {
+    for (int j = 0; j < grid.y.count; ++j) {
+      double y = s21::SampleCache::Position(grid.y.level, grid.y.first + j);
+      for (int i = 0; i < grid.x.count; ++i) {
+        double x = s21::SampleCache::Position(grid.x.level, grid.x.first + i);
+        ASSERT_NEAR(values[j * grid.x.count + i], Surface(x, y), EPS);
+      }
+    }
+  }
+};
+
+TEST_F(SurfaceCacheSuite, Pan) {
+  s21::SurfaceCache cache;
+  cache.SetFunction("x^2-3y", false);
+  s21::SurfaceCache::Grid grid =
+      s21::SurfaceCache::MakeGrid(-1.0, 1.0, 256, -2.0, 2.0, 256);
+  std::vector<double> values(grid.x.count * grid.y.count);
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  Check(grid, values);
+  int first = tiles;
+  EXPECT_EQ(static_cast<size_t>(first), cache.Size());
+  tiles = 0;
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  EXPECT_EQ(tiles, 0);
+  tiles = 0;
+  grid.x.first += s21::SurfaceCache::TILE_SIZE;
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  Check(grid, values);
+  EXPECT_GT(tiles, 0);
+  EXPECT_LT(tiles * 4, first);
+}
+
+TEST_F(SurfaceCacheSuite, Functions) {
+  s21::SurfaceCache cache;
+  s21::SurfaceCache::Grid grid =
+      s21::SurfaceCache::MakeGrid(0.0, 1.0, 100, 0.0, 1.0, 100);
+  std::vector<double> values(grid.x.count * grid.y.count);
+  cache.SetFunction("x^2-3y", false);
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  int first = tiles;
+  cache.SetFunction("x^2-3y", true);
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  EXPECT_EQ(tiles, 2 * first);
+  cache.SetFunction("x^2-3y", false);
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  EXPECT_EQ(tiles, 2 * first);
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0U);
+}
+
+TEST_F(SurfaceCacheSuite, EvictedFunctions) {
+  s21::SurfaceCache cache(1);
+  s21::SurfaceCache::Grid grid =
+      s21::SurfaceCache::MakeGrid(0.0, 0.5, 8, 0.0, 0.5, 8);
+  std::vector<double> values(grid.x.count * grid.y.count);
+  for (int i = 0; i < 50; ++i) {
+    cache.SetFunction(std::to_string(i) + "x", false);
+    ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  }
+  tiles = 0;
+  cache.SetFunction("49x", false);
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  EXPECT_EQ(tiles, 0);
+  cache.SetFunction("48x", false);
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  EXPECT_EQ(tiles, 1);
+}
+
+TEST_F(SurfaceCacheSuite, Stop) {
+  s21::SurfaceCache cache;
+  cache.SetFunction("x", false);
+  s21::SurfaceCache::Grid grid =
+      s21::SurfaceCache::MakeGrid(0.0, 1.0, 200, 0.0, 1.0, 200);
+  std::vector<double> values(grid.x.count * grid.y.count, 0.0);
+  std::atomic<int> calls{0};
+  EXPECT_FALSE(cache.Fill(
+      grid,
+      [&calls](const double*, const double*, double* z, size_t count) {
+        std::fill(z, z + count, 1.0);
+        return ++calls < 3;
+      },
+      values.data(), 1));
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(cache.Size(), 2U);
+  EXPECT_TRUE(std::isnan(values.back()));
+  tiles = 0;
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  EXPECT_EQ(tiles, static_cast<int>(cache.Size()) - 2);
+}
+
+TEST_F(SurfaceCacheSuite, Eviction) {
+  s21::SurfaceCache cache(4);
+  cache.SetFunction("x", false);
+  s21::SurfaceCache::Grid grid =
+      s21::SurfaceCache::MakeGrid(0.0, 1.0, 300, 0.0, 1.0, 300);
+  std::vector<double> values(grid.x.count * grid.y.count);
+  ASSERT_TRUE(cache.Fill(grid, evaluate, values.data()));
+  Check(grid, values);
+  EXPECT_EQ(cache.Size(), 4U);
+}
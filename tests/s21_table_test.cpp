@@ -0,0 +1,108 @@
+#include "s21_test_main.h"
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  return ::testing::TempDir() + "s21_table_" + name;
+}
+
+/* Write table and read it back as dataset, x column is evaluated again to
+ * compare with y column. */
+void CheckTable(const s21::Table::Options& options, int columns, double eps) {
+  const std::string path = TempPath(
+      options.format == s21::Dataset::CSV ? "test.csv" : "test.bin");
+  s21::Calculation calculation;
+  calculation.SetExpression("sqrt(x) * sin(x)");
+  ASSERT_TRUE(calculation.Compile());
+  s21::Table table(options);
+  unsigned long long last = 0;
+  ASSERT_EQ(table.Write(calculation, -1.0, 99.99, 0.01, path,
+                        [&last](unsigned long long rows) {
+                          EXPECT_GT(rows, last);
+                          last = rows;
+                          return true;
+                        }),
+            s21::Table::COMPLETED);
+  EXPECT_EQ(last, 10100U);
+  std::vector<double> x, y;
+  s21::Dataset dataset;
+  ASSERT_TRUE(dataset.Open(path, options.format, 0, columns,
+                           options.separator));
+  ASSERT_TRUE(dataset.Read([&x](const double* values, const double*,
+                                size_t count) {
+    x.insert(x.end(), values, values + count);
+  }));
+  ASSERT_TRUE(dataset.Open(path, options.format, 1, columns,
+                           options.separator));
+  ASSERT_TRUE(dataset.Read([&y](const double* values, const double*,
+                                size_t count) {
+    y.insert(y.end(), values, values + count);
+  }));
+  ASSERT_EQ(x.size(), 10100U);
+  ASSERT_EQ(y.size(), 10100U);
+  EXPECT_NEAR(x.front(), -1.0, eps);
+  EXPECT_NEAR(x.back(), 99.99, 1e-9);
+  std::vector<double> expected(x.size());
+  calculation.GetResults(x.data(), expected.data(), x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(x[i], -1.0 + i * 0.01, 1e-9);
+    if (std::isnan(expected[i])) {
+      EXPECT_TRUE(std::isnan(y[i]));
+    } else {
+      EXPECT_NEAR(y[i], expected[i], eps);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TableSuite, Rows) {
+  EXPECT_EQ(s21::Table::Rows(0.0, 1.0, 0.1), 11U);
+  EXPECT_EQ(s21::Table::Rows(0.0, 1.05, 0.1), 11U);
+  EXPECT_EQ(s21::Table::Rows(1.0, 0.0, -0.25), 5U);
+  EXPECT_EQ(s21::Table::Rows(2.0, 2.0, 0.5), 1U);
+  EXPECT_EQ(s21::Table::Rows(0.0, 1.0, -0.1), 0U);
+  EXPECT_EQ(s21::Table::Rows(0.0, 1.0, 0.0), 0U);
+  EXPECT_EQ(s21::Table::Rows(0.0, NAN, 0.1), 0U);
+  EXPECT_EQ(s21::Table::Rows(-1e6, 1e6, 1e-12), 0U);
+  EXPECT_EQ(s21::Table::Rows(0.0, 1e300, 1e-300), 0U);
+  EXPECT_EQ(s21::Table::Rows(0.0, s21::Table::MAX_ROWS / 2, 1.0),
+            s21::Table::MAX_ROWS / 2 + 1);
+  EXPECT_EQ(s21::Table::Rows(0.0, s21::Table::MAX_ROWS, 1.0), 0U);
+}
+
+TEST(TableSuite, Csv) {
+  s21::Table::Options options;
+  CheckTable(options, 2, 1e-12);
+  options.output = s21::Table::MAPPED;
+  options.separator = ';';
+  options.precision = 0;
+  CheckTable(options, 2, 0.0);
+}
+
+TEST(TableSuite, Binary) {
+  s21::Table::Options options;
+  options.format = s21::Dataset::BINARY;
+  CheckTable(options, 2, 0.0);
+  options.output = s21::Table::MAPPED;
+  CheckTable(options, 2, 0.0);
+}
+
+TEST(TableSuite, Errors) {
+  s21::Calculation calculation;
+  calculation.SetExpression("x");
+  ASSERT_TRUE(calculation.Compile());
+  s21::Table table;
+  EXPECT_EQ(table.Write(calculation, 0.0, 1.0, -1.0, TempPath("range.csv")),
+            s21::Table::RANGE_ERROR);
+  EXPECT_EQ(table.Write(calculation, 0.0, 1.0, 0.5,
+                        TempPath("missing/table.csv")),
+            s21::Table::OPEN_ERROR);
+  EXPECT_EQ(table.Write(calculation, 0.0, 100000.0, 1.0, TempPath("stop.csv"),
+                        [](unsigned long long) { return false; }),
+            s21::Table::CANCELLED);
+  calculation.SetExpression("2 + )");
+  calculation.Compile();
+  EXPECT_EQ(table.Write(calculation, 0.0, 1.0, 0.5, TempPath("bad.csv")),
+            s21::Table::CALCULATE_ERROR);
+}
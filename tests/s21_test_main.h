@@ -10,7 +10,19 @@
 #include "../model/s21_calculation.h"
 #include "../model/s21_common.h"
 #include "../model/s21_credit.h"
+#include "../model/s21_curve_sampler.h"
+#include "../model/s21_dataset.h"
 #include "../model/s21_deposit.h"
+#include "../model/s21_format.h"
+#include "../model/s21_implicit_curve.h"
+#include "../model/s21_integration.h"
+#include "../model/s21_parallel.h"
+#include "../model/s21_reduction.h"
+#include "../model/s21_ring_buffer.h"
+#include "../model/s21_sample_cache.h"
+#include "../model/s21_statistics.h"
+#include "../model/s21_surface_cache.h"
+#include "../model/s21_table.h"
 
 #define EPS 1e-07
 #define DECIMAL_EPS 0.05
@@ -29,16 +41,9 @@ class TestDeposit {
 
  private:
   static Date proceedDate(std::string& str) {
-    int d, m, y;
-    std::string token;
-    std::stringstream dss(str);
-    std::getline(dss, token, '.');
-    d = std::stoi(token);
-    std::getline(dss, token, '.');
-    m = std::stoi(token);
-    std::getline(dss, token, '.');
-    y = std::stoi(token);
-    return Date(d, m, y);
+    Date date(1, 1, 1900);
+    EXPECT_TRUE(Date::parse(str, date)) << str;
+    return date;
   }
 
   static void checkEvent(Deposit& instance, std::stringstream& ss, size_t& id,